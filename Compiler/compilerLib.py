@@ -147,6 +147,13 @@ class Compiler:
             dest="profile",
             help="profile compilation",
         )
+        parser.add_option(
+            "-L",
+            "--locations",
+            action="store_true",
+            dest="locations",
+            help="store source locations for profiling at run time",
+        )
         parser.add_option(
             "-s",
             "--stop",
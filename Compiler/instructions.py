@@ -489,6 +489,26 @@ class join_tape(base.Instruction):
     code = base.opcodes['JOIN_TAPE']
     arg_format = ['int']
 
+class initchunks(base.DoNotEliminateInstruction):
+    """ Prepare handing out chunks of work to threads started
+    afterwards. See :py:func:`~Compiler.library.for_range_steal_multithread`.
+
+    :param: number of chunks (regint)
+    :param: number of threads asking for chunks (int)
+    """
+    code = base.opcodes['INITCHUNKS']
+    arg_format = ['ci','int']
+
+class nextchunk(base.DoNotEliminateInstruction):
+    """ Store the number of the next chunk of work to be done by the
+    current thread in clear integer register, or -1 if there is none
+    left. The first party decides and informs the others.
+
+    :param: destination (regint)
+    """
+    code = base.opcodes['NEXTCHUNK']
+    arg_format = ['ciw']
+
 class call_tape(base.DoNotEliminateInstruction):
     """ Start tape/bytecode file in same thread. Arguments/return values
     starting from :py:obj:`direction` are optional.
@@ -5,6 +5,7 @@ import inspect
 import functools
 import copy
 import sys
+import os
 import struct
 from Compiler.exceptions import *
 from Compiler.config import *
@@ -70,6 +71,8 @@ opcodes = dict(
     CMDLINEARG = 0xEB,
     CALL_TAPE = 0xEC,
     CALL_ARG = 0xED,
+    INITCHUNKS = 0xEE,
+    NEXTCHUNK = 0xEF,
     # Addition
     ADDC = 0x20,
     ADDS = 0x21,
@@ -246,6 +249,7 @@ def int_to_bytes(x):
 
 global_vector_size_stack = []
 global_instruction_type_stack = ['modp']
+global_location_stack = []
 
 def check_vector_size(size):
     if isinstance(size, program.curr_tape.Register):
@@ -272,6 +276,24 @@ def reset_global_vector_size():
 def reset_global_instruction_type():
     global_instruction_type_stack.pop()
 
+def get_source_location():
+    """ Call stack within the high-level program as
+    'file:line;file:line;...', outermost first. Instructions created
+    outside the program such as expanded CISC instructions inherit the
+    location of the originating call. """
+    frames = []
+    frame = sys._getframe(1)
+    while frame:
+        filename = frame.f_code.co_filename
+        if filename.endswith('.mpc'):
+            frames.append('%s:%d' % (os.path.basename(filename),
+                                     frame.f_lineno))
+        frame = frame.f_back
+    if frames:
+        return ';'.join(reversed(frames))
+    elif global_location_stack:
+        return global_location_stack[-1]
+
 def get_global_vector_size():
     stack = global_vector_size_stack
     if stack:
@@ -459,6 +481,8 @@ def cisc(function, n_outputs=1):
                     self.params.append(arg)
             self.function = function
             self.caller = None
+            if program.locations:
+                self.location = get_source_location()
             program.curr_block.instructions.append(self)
 
         def get_def(self):
@@ -623,6 +647,9 @@ def cisc(function, n_outputs=1):
                     return program.curr_block.instructions.append(self)
             if program.verbose:
                 print('expanding', self.function.__name__)
+            if program.locations:
+                global_location_stack.append(';'.join(
+                    filter(None, (self.location, self.function.__name__))))
             tape = program.curr_tape
             tape.start_new_basicblock(name='pre-' + self.name())
             size = sum(call[0][0].vector_size() for call in self.calls)
@@ -658,6 +685,8 @@ def cisc(function, n_outputs=1):
                     reg.copy_from_part(new_regs[i], base, reg.vector_size())
                 base += reg.vector_size()
             tape.start_new_basicblock(name='post-' + self.name())
+            if program.locations:
+                global_location_stack.pop()
 
         def add_usage(self, *args):
             pass
@@ -982,7 +1011,7 @@ class Instruction(object):
     Base class for a RISC-type instruction. Has methods for checking arguments,
     getting byte encoding, emulating the instruction, etc.
     """
-    __slots__ = ['args', 'arg_format', 'code', 'caller']
+    __slots__ = ['args', 'arg_format', 'code', 'caller', 'location']
     count = 0
     code_length = 10
 
@@ -997,6 +1026,10 @@ class Instruction(object):
             self.caller = [frame[1:] for frame in inspect.stack()[1:]]
         else:
             self.caller = None
+        if program.locations:
+            self.location = get_source_location()
+        else:
+            self.location = None
         
         Instruction.count += 1
         if Instruction.count % 100000 == 0:
@@ -1258,6 +1258,60 @@ def for_range_opt_multithread(n_threads, n_loops, budget=None):
     """
     return for_range_multithread(n_threads, None, n_loops, budget=budget)
 
+def for_range_steal_multithread(n_threads, n_loops, chunk_size=1):
+    """
+    Execute :py:obj:`n_loops` loop bodies in up to :py:obj:`n_threads`
+    threads, handing out :py:obj:`chunk_size` loop bodies at a time to
+    whichever thread is idle. Unlike :py:func:`for_range_multithread`,
+    this balances the load if loop bodies take different amounts of
+    time. The assignment of loop bodies to threads is only determined
+    at run time, which takes one message from the first party per
+    chunk.
+
+    :param n_threads/chunk_size: compile-time (int)
+    :param n_loops: regint/cint/int
+
+    The following executes loop bodies in chunks of ten in four
+    threads:
+
+    .. code::
+
+        @for_range_steal_multithread(4, 1000, 10)
+        def _(i):
+            ...
+
+    """
+    assert n_threads > 0
+    assert chunk_size > 0
+    if not util.is_constant(n_loops):
+        n_loops = MemValue(regint.conv(n_loops))
+    def decorator(loop_body):
+        prevent_breaks = get_program().prevent_breaks
+        def f():
+            get_program().prevent_breaks = prevent_breaks
+            @do_while
+            def _():
+                chunk = regint()
+                nextchunk(chunk)
+                @if_(chunk >= 0)
+                def _():
+                    base = chunk * chunk_size
+                    stop = util.min(base + chunk_size, n_loops)
+                    @for_range(base, stop)
+                    def _(i):
+                        loop_body(i)
+                return chunk >= 0
+        prog = get_program()
+        prog.prevent_breaks = False
+        tape = prog.new_tape(f, name='multithread_steal')
+        initchunks(regint.conv((n_loops + chunk_size - 1) // chunk_size),
+                   n_threads)
+        threads = prog.run_tapes([tape] * n_threads)
+        prog.join_tapes(threads)
+        prog.free_later()
+        prog.prevent_breaks = prevent_breaks
+    return decorator
+
 def multithread(n_threads, n_items=None, max_size=None):
     """
     Distribute the computation of :py:obj:`n_items` to
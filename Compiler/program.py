@@ -70,6 +70,7 @@ class defaults:
     stop = False
     insecure = False
     keep_cisc = False
+    locations = False
 
 
 class Program(object):
@@ -163,6 +164,7 @@ class Program(object):
         self.tape_counter = 0
         self._curr_tape = None
         self.DEBUG = options.debug
+        self.locations = options.locations
         self.allocated_mem = RegType.create_dict(lambda: USER_MEM)
         self.free_mem_blocks = defaultdict(al.BlockAllocator)
         self.later_mem_blocks = defaultdict(list)
@@ -1419,6 +1421,19 @@ class Tape:
                 h.update(b)
         f.close()
         self.hash = h.digest()
+        if self.program.locations:
+            self.write_locations(filename[:-3] + ".loc")
+
+    @unpurged
+    def write_locations(self, filename):
+        """Write the source location of every instruction to a file,
+        one line per instruction in bytecode order."""
+        print("Writing to", filename)
+        f = open(filename, "w")
+        for i in self._get_instructions():
+            if i is not None:
+                f.write("%s\n" % (getattr(i, "location", None) or "-"))
+        f.close()
 
     def new_reg(self, reg_type, size=None):
         return self.Register(reg_type, self, size=size)
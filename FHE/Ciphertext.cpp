@@ -69,16 +69,20 @@ void mul(Ciphertext& ans,const Ciphertext& c0,const Ciphertext& c1,
   Ciphertext cc0=c0,cc1=c1;
   cc0.Scale(pk.p()); cc1.Scale(pk.p());
   
-  // Now do the multiply
-  auto d0 = cc0.cc0 * cc1.cc0;
-  auto d1 = cc0.cc0 * cc1.cc1 + cc0.cc1 * cc1.cc0;
-  auto d2 = cc0.cc1 * cc1.cc1;
+  // Now do the multiply, without operator temporaries
+  Rq_Element d0(*c0.params), d1(*c0.params), d2(*c0.params),
+      t(*c0.params);
+  mul(d0, cc0.cc0, cc1.cc0);
+  mul(d1, cc0.cc0, cc1.cc1);
+  mul(t, cc0.cc1, cc1.cc0);
+  add(d1, d1, t);
+  mul(d2, cc0.cc1, cc1.cc1);
   d2.negate(); 
 
   // Now do the switch key
   d2.raise_level();
   d0.mul_by_p1();
-  auto t =  pk.bs()* d2;
+  mul(t,pk.bs(),d2);
   add(d0,d0,t);
 
   d1.mul_by_p1();
@@ -122,7 +126,9 @@ void Ciphertext::rerandomize(const FHE_PK& pk)
 {
   Rq_Element tmp(*params);
   SeededPRNG G;
-  vector<FFT_Data::S> r(params->FFTD()[0].phi_m());
+  // keep the limbs allocated across calls
+  thread_local vector<FFT_Data::S> r;
+  r.resize(params->FFTD()[0].phi_m());
   bigint p = pk.p();
   assert(p != 0);
   for (auto& x : r)
@@ -133,7 +139,11 @@ void Ciphertext::rerandomize(const FHE_PK& pk)
   tmp.from(r, 0);
   Scale();
   cc0 += tmp;
-  auto zero = pk.encrypt(*params);
+  // encryption of zero without another PRNG and copies of the result
+  Random_Coins rc(*params);
+  rc.generate(G);
+  Ciphertext zero(*params);
+  pk.quasi_encrypt(zero, Rq_Element(*params), rc);
   zero.Scale(pk.p());
   *this += zero;
 }
@@ -0,0 +1,41 @@
+/*
+ * ElementPool.cpp
+ *
+ */
+
+#include "ElementPool.h"
+
+#include <algorithm>
+
+vector<ElementPoolBase*>& ElementPoolBase::pools()
+{
+    // constructed before and thus destroyed after any pool
+    thread_local vector<ElementPoolBase*> pools;
+    return pools;
+}
+
+ElementPoolBase::ElementPoolBase() :
+        n_free(0), n_bytes(0)
+{
+    pools().push_back(this);
+}
+
+ElementPoolBase::~ElementPoolBase()
+{
+    auto& pools = this->pools();
+    pools.erase(find(pools.begin(), pools.end(), this));
+}
+
+size_t ElementPoolBase::report_size()
+{
+    size_t res = 0;
+    for (auto pool : pools())
+        res += pool->n_bytes;
+    return res;
+}
+
+void ElementPoolBase::release()
+{
+    for (auto pool : pools())
+        pool->clear();
+}
@@ -0,0 +1,139 @@
+/*
+ * ElementPool.h
+ *
+ */
+
+#ifndef FHE_ELEMENTPOOL_H_
+#define FHE_ELEMENTPOOL_H_
+
+#include <map>
+#include <vector>
+using namespace std;
+
+/*
+ * Per-thread storage for the coefficient vectors of ring elements and
+ * plaintexts. These take their memory from here and return it on
+ * destruction, so the temporaries in ciphertext and plaintext arithmetic
+ * stop allocating after the first round. Free vectors are kept by
+ * capacity, which is the ring dimension or the number of slots for all
+ * elements of the same FHE_Params.
+ */
+class ElementPoolBase
+{
+    static vector<ElementPoolBase*>& pools();
+
+protected:
+    static const size_t MAX_FREE = 32;
+
+    size_t n_free, n_bytes;
+
+    ElementPoolBase();
+    virtual ~ElementPoolBase();
+
+    virtual void clear() = 0;
+
+public:
+    // memory held for reuse by the pools of this thread
+    static size_t report_size();
+    // return that memory
+    static void release();
+};
+
+template<class T>
+class ElementPool : public ElementPoolBase
+{
+    map<size_t, vector<vector<T>>> free;
+    bool& destroyed;
+
+    ElementPool(bool& destroyed) : destroyed(destroyed) {}
+    ~ElementPool() { destroyed = true; }
+
+    void clear()
+    {
+        free.clear();
+        n_free = 0;
+        n_bytes = 0;
+    }
+
+public:
+    // null during thread shutdown
+    static ElementPool* get();
+
+    // make x empty with capacity for at least n elements
+    static void take(vector<T>& x, size_t n);
+    // keep the memory of x, leaving it empty
+    static void give(vector<T>& x);
+    // capacity for at least n elements, keeping the content
+    static void reserve(vector<T>& x, size_t n);
+};
+
+template<class T>
+ElementPool<T>* ElementPool<T>::get()
+{
+    // trivial type, so still usable after the pool is gone
+    thread_local bool destroyed = false;
+    if (destroyed)
+        return 0;
+    thread_local ElementPool pool(destroyed);
+    return &pool;
+}
+
+template<class T>
+void ElementPool<T>::take(vector<T>& x, size_t n)
+{
+    x.clear();
+    if (x.capacity() >= n)
+        return;
+
+    auto pool = get();
+    if (pool)
+    {
+        auto it = pool->free.lower_bound(n);
+        if (it != pool->free.end())
+        {
+            x.swap(it->second.back());
+            it->second.pop_back();
+            pool->n_free--;
+            pool->n_bytes -= x.capacity() * sizeof(T);
+            if (it->second.empty())
+                pool->free.erase(it);
+            return;
+        }
+    }
+
+    x = {};
+    x.reserve(n);
+}
+
+template<class T>
+void ElementPool<T>::give(vector<T>& x)
+{
+    if (x.capacity() == 0)
+        return;
+
+    auto pool = get();
+    if (pool and pool->n_free < MAX_FREE)
+    {
+        x.clear();
+        pool->n_bytes += x.capacity() * sizeof(T);
+        auto& free = pool->free[x.capacity()];
+        free.push_back({});
+        free.back().swap(x);
+        pool->n_free++;
+    }
+    else
+        x = {};
+}
+
+template<class T>
+void ElementPool<T>::reserve(vector<T>& x, size_t n)
+{
+    if (x.capacity() >= n)
+        return;
+    if (x.empty())
+        take(x, n);
+    else
+        x.reserve(n);
+}
+
+#endif /* FHE_ELEMENTPOOL_H_ */
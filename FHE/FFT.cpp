@@ -251,12 +251,18 @@ void BFFT(vector<modp>& ans,const vector<modp>& a,const FFT_Data& FFTD,bool forw
          { Mul(x[i],FFTD.powers[r][i],a[i],FFTD.get_prD()); }
        for (int i=a.size(); i<k2; i++)
          { assignZero(x[i],FFTD.get_prD()); }
-       FFT_Iter(x,k2,FFTD.two_root[0],FFTD.get_prD());
+       if (FFTD.ntt[0].active())
+         FFTD.ntt[0].apply(x);
+       else
+         FFT_Iter(x,k2,FFTD.two_root[0],FFTD.get_prD());
      
        for (int i=0; i<k2; i++)
           { Mul(x[i],x[i],FFTD.b[r][i],FFTD.get_prD()); }
      
-       FFT_Iter(x,k2,FFTD.two_root[1],FFTD.get_prD());
+       if (FFTD.ntt[1].active())
+         FFTD.ntt[1].apply(x);
+       else
+         FFT_Iter(x,k2,FFTD.two_root[1],FFTD.get_prD());
        
        for (int i=0; i<n; i++)
          { Mul(ans[i],x[i+n-1],FFTD.powers_i[r][i],FFTD.get_prD()); }
@@ -86,6 +86,28 @@ void FFT_Data::init(const Ring& Rg,const Zp_Data& PrD)
       else
         throw bad_value();
     }
+
+  init_ntt();
+}
+
+void FFT_Data::init_ntt()
+{
+  for (auto& x : ntt)
+    x = {};
+  if (twop < 0 or not NTT::fits(prData))
+    return;
+
+  if (twop == 0)
+    { ntt[0].init(phi_m(), root[0], prData, false);
+      modp root2;
+      Sqr(root2, root[1], prData);
+      ntt[1].init(phi_m(), root2, prData);
+      ntt[1].set_scale(iphi, root[1], prData);
+    }
+  else
+    { for (int r = 0; r < 2; r++)
+        ntt[r].init(twop, two_root[r], prData);
+    }
 }
 
 void FFT_Data::compute_roots(int n)
@@ -132,6 +154,7 @@ void FFT_Data::unpack(octetStream& o)
   iphi.unpack(o);
   o.get(powers);
   o.get(powers_i);
+  init_ntt();
 }
 
 bool FFT_Data::operator!=(const FFT_Data& other) const
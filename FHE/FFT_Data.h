@@ -6,6 +6,7 @@
 #include "Math/gfpvar.h"
 #include "Math/fixint.h"
 #include "FHE/Ring.h"
+#include "FHE/NTT.h"
 
 /* Class for holding modular arithmetic data wrt the ring 
  *
@@ -35,7 +36,14 @@ class FFT_Data
   modp iphi;    // 1/phi_m mod pr
   vector< vector<modp> > powers,powers_i;
 
+  // Word-sized transforms if the prime has at most 62 bits, in the same
+  // direction as root, or two_root if twop is positive. This only holds
+  // for plaintext moduli; the ciphertext primes are larger and always
+  // use the generic modp transforms.
+  NTT ntt[2];
+
   void compute_roots(int n);
+  void init_ntt();
 
   public:
   typedef gfp T;
@@ -68,6 +76,7 @@ class FFT_Data
   modp get_root(int i) const     { return root[i];    }
   modp get_iphi() const          { return iphi;       }
   const vector<modp>& get_roots() const { return roots; }
+  const NTT& get_ntt(int i) const { return ntt[i]; }
 
   const Ring& get_R() const      { return R; }
 
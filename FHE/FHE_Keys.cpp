@@ -160,12 +160,18 @@ void FHE_PK::quasi_encrypt(Ciphertext& c,
   if (&rc.get_params()!=params) { throw params_mismatch(); }
   assert(pr != 0);
 
+  // in place to avoid operator temporaries
+  Rq_Element c0(*params), c1(*params), edd(*params);
+
   // c1=a0*u+p*v
-  auto c1 = a0 * rc.u() + rc.v() * pr;
+  mul(c1, a0, rc.u());
+  mul(edd, rc.v(), pr);
+  add(c1, c1, edd);
 
   // c0 = b0 * u + p * w + mess
-  auto c0 = b0 * rc.u();
-  auto edd = rc.w() * pr + mess;
+  mul(c0, b0, rc.u());
+  mul(edd, rc.w(), pr);
+  add(edd, edd, mess);
   if (params->n_mults() == 0)
     edd.change_rep(evaluation);
   else
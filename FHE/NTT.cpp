@@ -0,0 +1,276 @@
+/*
+ * NTT.cpp
+ *
+ */
+
+#include "NTT.h"
+#include "Tools/cpu_support.h"
+#include "Tools/CodeLocations.h"
+
+#include "Math/modp.hpp"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+inline uint64_t mul_mod(uint64_t x, uint64_t y, uint64_t p)
+{
+    return (__uint128_t) x * y % p;
+}
+
+inline uint64_t shoup(uint64_t w, uint64_t p)
+{
+    return ((__uint128_t) w << 64) / p;
+}
+
+// x * w mod p in [0, 2p) for any x
+inline uint64_t mul_lazy(uint64_t x, uint64_t w, uint64_t w_shoup, uint64_t p)
+{
+    uint64_t q = ((__uint128_t) x * w_shoup) >> 64;
+    return x * w - q * p;
+}
+
+inline uint64_t reduce(uint64_t x, uint64_t bound)
+{
+    return x >= bound ? x - bound : x;
+}
+
+// inputs and outputs in [0, 4p)
+inline void butterfly(uint64_t& x, uint64_t& y, uint64_t w, uint64_t w_shoup,
+        uint64_t p)
+{
+    uint64_t u = reduce(x, 2 * p);
+    uint64_t t = mul_lazy(y, w, w_shoup, p);
+    x = u + t;
+    y = u - t + 2 * p;
+}
+
+#ifdef __AVX2__
+
+inline __m256i load(const uint64_t* x)
+{
+    return _mm256_loadu_si256((const __m256i*) x);
+}
+
+inline void store(uint64_t* x, __m256i y)
+{
+    _mm256_storeu_si256((__m256i*) x, y);
+}
+
+// AVX2 only multiplies 32-bit halves
+inline __m256i mulhi(__m256i x, __m256i y)
+{
+    __m256i x_hi = _mm256_srli_epi64(x, 32);
+    __m256i y_hi = _mm256_srli_epi64(y, 32);
+    __m256i lo = _mm256_mul_epu32(x, y);
+    __m256i mid1 = _mm256_mul_epu32(x_hi, y);
+    __m256i mid2 = _mm256_mul_epu32(x, y_hi);
+    __m256i hi = _mm256_mul_epu32(x_hi, y_hi);
+    __m256i mask = _mm256_set1_epi64x(0xFFFFFFFF);
+    __m256i mid = _mm256_add_epi64(_mm256_srli_epi64(lo, 32),
+            _mm256_add_epi64(_mm256_and_si256(mid1, mask),
+                    _mm256_and_si256(mid2, mask)));
+    hi = _mm256_add_epi64(hi, _mm256_srli_epi64(mid1, 32));
+    hi = _mm256_add_epi64(hi, _mm256_srli_epi64(mid2, 32));
+    return _mm256_add_epi64(hi, _mm256_srli_epi64(mid, 32));
+}
+
+inline __m256i mullo(__m256i x, __m256i y)
+{
+    __m256i cross = _mm256_add_epi64(
+            _mm256_mul_epu32(_mm256_srli_epi64(x, 32), y),
+            _mm256_mul_epu32(x, _mm256_srli_epi64(y, 32)));
+    return _mm256_add_epi64(_mm256_mul_epu32(x, y),
+            _mm256_slli_epi64(cross, 32));
+}
+
+// relies on all results being below 2^63,
+// so the sign bit indicates an underflow
+inline __m256i reduce(__m256i x, __m256i bound)
+{
+    __m256d d = _mm256_castsi256_pd(_mm256_sub_epi64(x, bound));
+    return _mm256_castpd_si256(
+            _mm256_blendv_pd(d, _mm256_castsi256_pd(x), d));
+}
+
+inline __m256i mul_lazy(__m256i x, __m256i w, __m256i w_shoup, __m256i p)
+{
+    __m256i q = mulhi(x, w_shoup);
+    return _mm256_sub_epi64(mullo(x, w), mullo(q, p));
+}
+
+inline void butterfly(__m256i& x, __m256i& y, __m256i w, __m256i w_shoup,
+        __m256i p, __m256i two_p)
+{
+    __m256i u = reduce(x, two_p);
+    __m256i t = mul_lazy(y, w, w_shoup, p);
+    x = _mm256_add_epi64(u, t);
+    y = _mm256_add_epi64(_mm256_sub_epi64(u, t), two_p);
+}
+
+#endif
+
+}
+
+bool NTT::fits(const Zp_Data& PrD)
+{
+    return PrD.pr > 1 and numBits(PrD.pr) <= MAX_BITS;
+}
+
+void NTT::init(int n, const modp& root, const Zp_Data& PrD,
+        bool start_with_one)
+{
+    assert(fits(PrD));
+    assert(n > 0 and (n & (n - 1)) == 0);
+    this->n = n;
+    p = PrD.pr.get_ui();
+
+    bigint tmp;
+    to_bigint(tmp, root, PrD);
+    vector<uint64_t> powers(n);
+    powers[0] = 1;
+    for (int i = 1; i < n; i++)
+        powers[i] = mul_mod(powers[i - 1], tmp.get_ui(), p);
+
+    w.resize(n);
+    w_shoup.resize(n);
+    for (int h = 1; h < n; h *= 2)
+        for (int j = 0; j < h; j++)
+        {
+            w[h + j] = powers[(start_with_one ? j : 2 * j + 1) * (n / (2 * h))];
+            w_shoup[h + j] = shoup(w[h + j], p);
+        }
+
+    scale.clear();
+    scale_shoup.clear();
+}
+
+void NTT::set_scale(const modp& first, const modp& ratio, const Zp_Data& PrD)
+{
+    assert(active());
+    bigint tmp;
+    to_bigint(tmp, ratio, PrD);
+    uint64_t r = tmp.get_ui();
+    to_bigint(tmp, first, PrD);
+    uint64_t x = tmp.get_ui();
+    scale.resize(n);
+    scale_shoup.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+        scale[i] = x;
+        scale_shoup[i] = shoup(x, p);
+        x = mul_mod(x, r, p);
+    }
+}
+
+void NTT::stages(uint64_t* a, int size, int h_start, int h_end) const
+{
+#ifdef __AVX2__
+    bool avx2 = cpu_has_avx2();
+    __m256i pp = _mm256_set1_epi64x(p);
+    __m256i two_p = _mm256_set1_epi64x(2 * p);
+#endif
+
+    // two stages at once
+    int h = h_start;
+    for (; 2 * h < h_end; h *= 4)
+        for (int k = 0; k < size; k += 4 * h)
+        {
+            int j = 0;
+#ifdef __AVX2__
+            if (avx2)
+                for (; j + 4 <= h; j += 4)
+                {
+                    uint64_t* x = a + k + j;
+                    __m256i x0 = load(x), x1 = load(x + h), x2 = load(x + 2 * h),
+                            x3 = load(x + 3 * h);
+                    __m256i w1 = load(&w[h + j]), w1_shoup = load(&w_shoup[h + j]);
+                    butterfly(x0, x1, w1, w1_shoup, pp, two_p);
+                    butterfly(x2, x3, w1, w1_shoup, pp, two_p);
+                    butterfly(x0, x2, load(&w[2 * h + j]),
+                            load(&w_shoup[2 * h + j]), pp, two_p);
+                    butterfly(x1, x3, load(&w[3 * h + j]),
+                            load(&w_shoup[3 * h + j]), pp, two_p);
+                    store(x, x0);
+                    store(x + h, x1);
+                    store(x + 2 * h, x2);
+                    store(x + 3 * h, x3);
+                }
+#endif
+            for (; j < h; j++)
+            {
+                uint64_t* x = a + k + j;
+                butterfly(x[0], x[h], w[h + j], w_shoup[h + j], p);
+                butterfly(x[2 * h], x[3 * h], w[h + j], w_shoup[h + j], p);
+                butterfly(x[0], x[2 * h], w[2 * h + j], w_shoup[2 * h + j], p);
+                butterfly(x[h], x[3 * h], w[3 * h + j], w_shoup[3 * h + j], p);
+            }
+        }
+
+    // odd number of stages
+    if (h < h_end)
+        for (int k = 0; k < size; k += 2 * h)
+        {
+            int j = 0;
+#ifdef __AVX2__
+            if (avx2)
+                for (; j + 4 <= h; j += 4)
+                {
+                    uint64_t* x = a + k + j;
+                    __m256i x0 = load(x), x1 = load(x + h);
+                    butterfly(x0, x1, load(&w[h + j]), load(&w_shoup[h + j]),
+                            pp, two_p);
+                    store(x, x0);
+                    store(x + h, x1);
+                }
+#endif
+            for (; j < h; j++)
+                butterfly(a[k + j], a[k + j + h], w[h + j], w_shoup[h + j], p);
+        }
+}
+
+void NTT::apply(uint64_t* a) const
+{
+    int block = BLOCK_SIZE;
+    block = min(n, block);
+    for (int i = 0; i < n; i += block)
+        stages(a + i, block, 1, block);
+    stages(a, n, block, n);
+
+    if (scale.empty())
+        for (int i = 0; i < n; i++)
+            a[i] = reduce(reduce(a[i], 2 * p), p);
+    else
+        for (int i = 0; i < n; i++)
+            a[i] = reduce(mul_lazy(a[i], scale[i], scale_shoup[i], p), p);
+}
+
+void NTT::apply(vector<modp>& a) const
+{
+    CODE_LOCATION
+
+    assert(a.size() == size_t(n));
+    thread_local static vector<uint64_t> buffer;
+    buffer.resize(n);
+
+    // bit-reversal as in FFT_Iter()
+    for (int i = 0, j = 0; i < n; i++)
+    {
+        buffer[j] = a[i].get()[0];
+        int m = n / 2;
+        while (m >= 1 and j >= m)
+        {
+            j -= m;
+            m /= 2;
+        }
+        j += m;
+    }
+
+    apply(buffer.data());
+
+    for (int i = 0; i < n; i++)
+        a[i].assign(&buffer[i], 1);
+}
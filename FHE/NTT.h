@@ -0,0 +1,60 @@
+/*
+ * NTT.h
+ *
+ */
+
+#ifndef FHE_NTT_H_
+#define FHE_NTT_H_
+
+#include "Math/modp.h"
+
+#include <vector>
+using namespace std;
+
+/*
+ * Number-theoretic transform on 64-bit words for primes below 2^62,
+ * that is, for plaintext moduli of up to 62 bits. The ciphertext
+ * modulus is not split into word-sized primes, so Rq_Element does not
+ * benefit from this.
+ * It computes the same as FFT_Iter() but uses lazy butterflies
+ * (Harvey) with precomputed twiddle quotients (Shoup),
+ * keeping intermediate values in [0, 4p).
+ * The first stages run block by block to stay in cache,
+ * and pairs of stages are merged into radix-4 passes.
+ * The transform is linear, so elements stay in Montgomery form.
+ */
+class NTT
+{
+    static const int MAX_BITS = 62;
+    static const int BLOCK_SIZE = 1 << 11;
+
+    uint64_t p;
+    int n;
+
+    // twiddles for the stage with half size h at [h, 2h)
+    vector<uint64_t> w, w_shoup;
+    // optional factors for the output
+    vector<uint64_t> scale, scale_shoup;
+
+    void stages(uint64_t* a, int size, int h_start, int h_end) const;
+
+public:
+    static bool fits(const Zp_Data& PrD);
+
+    NTT() : p(0), n(0) {}
+
+    // n a power of two, root n-th root of unity if start_with_one,
+    // otherwise 2n-th root of unity with only odd powers as in FFT_Iter2()
+    void init(int n, const modp& root, const Zp_Data& PrD,
+            bool start_with_one = true);
+    // multiply output i by first * ratio^i
+    void set_scale(const modp& first, const modp& ratio, const Zp_Data& PrD);
+
+    bool active() const { return n > 0; }
+
+    void apply(vector<modp>& a) const;
+    // input in bit-reversed order, output in [0, p)
+    void apply(uint64_t* a) const;
+};
+
+#endif /* FHE_NTT_H_ */
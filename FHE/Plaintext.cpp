@@ -43,10 +43,51 @@ int Plaintext<gf2n_short,P2Data,int>::degree() const
 }
 
 
+template<class T, class FD, class S>
+void Plaintext<T, FD, S>::resize_evaluation() const
+{
+  ElementPool<T>::reserve(a, num_slots());
+  a.resize(num_slots());
+}
+
+template<class T, class FD, class S>
+void Plaintext<T, FD, S>::resize_polynomial() const
+{
+  ElementPool<typename FD::poly_type>::reserve(b, degree());
+  b.resize(degree());
+}
+
+
+template<class T, class FD, class S>
+Plaintext<T, FD, S>& Plaintext<T, FD, S>::operator=(const Plaintext& other)
+{
+  if (this == &other)
+    return *this;
+  Field_Data = other.Field_Data;
+  type = other.type;
+  ElementPool<T>::reserve(a, other.a.size());
+  a = other.a;
+  ElementPool<typename FD::poly_type>::reserve(b, other.b.size());
+  b = other.b;
+  return *this;
+}
+
+template<class T, class FD, class S>
+Plaintext<T, FD, S>& Plaintext<T, FD, S>::operator=(Plaintext&& other)
+{
+  // other returns the old storage to the pool
+  Field_Data = other.Field_Data;
+  type = other.type;
+  a.swap(other.a);
+  b.swap(other.b);
+  return *this;
+}
+
+
 template<>
 void Plaintext<gfp, FFT_Data, bigint>::from(const Generator<bigint>& source) const
 {
-  b.resize(degree());
+  resize_polynomial();
   for (auto& x : b)
     {
       source.get(bigint::tmp);
@@ -63,7 +104,7 @@ void Plaintext<gfp,FFT_Data,bigint>::from_poly() const
   Ring_Element e(*Field_Data,polynomial);
   e.from(b);
   e.change_rep(evaluation);
-  a.resize(num_slots());
+  resize_evaluation();
   for (unsigned int i=0; i<a.size(); i++)
     a[i] = gfp(e.get_element(i), e.get_FFTD().get_prD());
   type=Both;
@@ -89,7 +130,7 @@ template<>
 void Plaintext<gf2n_short,P2Data,int>::from_poly() const
 { 
   if (type!=Polynomial) { return; }
-  a.resize(num_slots());
+  resize_evaluation();
   (*Field_Data).backward(a,b); 
   type=Both;
 }
@@ -109,9 +150,9 @@ template<class T, class FD, class S>
 void Plaintext<T, FD, S>::allocate(PT_Type type) const
 {
   if (type != Evaluation)
-    b.resize(degree());
+    resize_polynomial();
   if (type != Polynomial)
-    a.resize(num_slots());
+    resize_evaluation();
   this->type = type;
 }
 
@@ -119,7 +160,7 @@ void Plaintext<T, FD, S>::allocate(PT_Type type) const
 template<class T, class FD, class S>
 void Plaintext<T, FD, S>::allocate_slots(const bigint& value)
 {
-  b.resize(degree());
+  resize_polynomial();
   for (auto& x : b)
     x.allocate_slots(value);
 }
@@ -214,7 +255,7 @@ void Plaintext<T,FD,S>::randomize(PRNG& G,condition cond)
         type=Polynomial;
         break;
       case Diagonal:
-        a.resize(num_slots());
+        resize_evaluation();
         a[0].randomize(G);
         for (unsigned int i=1; i<a.size(); i++)
            { a[i]=a[0]; }
@@ -222,7 +263,7 @@ void Plaintext<T,FD,S>::randomize(PRNG& G,condition cond)
         break;
       default:
         // Gen a plaintext with 0/1 in each slot
-        a.resize(num_slots());
+        resize_evaluation();
 	for (unsigned int i=0; i<a.size(); i++)
            {
              if (G.get_bit())
@@ -266,7 +307,7 @@ void Plaintext<T,FD,S>::assign_zero(PT_Type t)
   allocate();
   if (type!=Polynomial)
     {
-      a.resize(num_slots());
+      resize_evaluation();
       for (unsigned int i=0; i<a.size(); i++)
         { a[i].assign_zero(); }
     }
@@ -284,7 +325,7 @@ void Plaintext<T,FD,S>::assign_one(PT_Type t)
   allocate();
   if (type!=Polynomial)
     {
-      a.resize(num_slots());
+      resize_evaluation();
       for (unsigned int i=0; i<a.size(); i++)
         { a[i].assign_one(); }
     }
@@ -337,7 +378,7 @@ void add(Plaintext<gfp,FFT_Data,bigint>& z,const Plaintext<gfp,FFT_Data,bigint>&
   z.allocate();
   if (z.type!=Polynomial)
     {
-      z.a.resize(z.num_slots());
+      z.resize_evaluation();
       for (unsigned int i=0; i<z.a.size(); i++)
         { z.a[i] = (x.a[i] + y.a[i]); }
     }
@@ -368,7 +409,7 @@ void add(Plaintext<gf2n_short,P2Data,int>& z,const Plaintext<gf2n_short,P2Data,i
   z.allocate();
   if (z.type!=Polynomial)
     {
-      z.a.resize(z.num_slots());
+      z.resize_evaluation();
       for (unsigned int i=0; i<z.a.size(); i++)
         { z.a[i].add(x.a[i],y.a[i]); }
     }
@@ -396,7 +437,7 @@ void sub(Plaintext<gfp,FFT_Data,bigint>& z,const Plaintext<gfp,FFT_Data,bigint>&
   z.allocate();
   if (z.type!=Polynomial)
     {
-      z.a.resize(z.num_slots());
+      z.resize_evaluation();
       for (unsigned int i=0; i<z.a.size(); i++)
         { z.a[i]= (x.a[i] - y.a[i]); }
     }
@@ -430,7 +471,7 @@ void sub(Plaintext<gf2n_short,P2Data,int>& z,const Plaintext<gf2n_short,P2Data,i
   z.allocate();
   if (z.type!=Polynomial)
     {
-      z.a.resize(z.num_slots());
+      z.resize_evaluation();
       for (unsigned int i=0; i<z.a.size(); i++)
         { z.a[i].sub(x.a[i],y.a[i]); }
     }
@@ -465,7 +506,7 @@ void Plaintext<gfp,FFT_Data,bigint>::negate()
 {
   if (type!=Polynomial)
     {
-      a.resize(num_slots());
+      resize_evaluation();
       for (unsigned int i=0; i<a.size(); i++)
         { a[i].negate(); }
     }
@@ -510,7 +551,7 @@ bool Plaintext<T,FD,S>::equals(const Plaintext& x) const
 
   if (type!=Polynomial and x.type!=Polynomial)
     {
-      a.resize(num_slots());
+      resize_evaluation();
       for (unsigned int i=0; i<a.size(); i++)
        { if (!(a[i] == x.a[i])) { return false; } }
     }
@@ -568,6 +609,7 @@ void Plaintext<T,FD,S>::pack(octetStream& o) const
 template <class T,class FD,class S>
 void Plaintext<T,FD,S>::unpack(octetStream& o)
 {
+  ElementPool<typename FD::poly_type>::reserve(b, degree());
   o.get(b);
   auto size = b.size();
   allocate(Polynomial);
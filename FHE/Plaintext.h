@@ -19,6 +19,7 @@
 
 #include "FHE/Generator.h"
 #include "FHE/FFT_Data.h"
+#include "FHE/ElementPool.h"
 #include "Math/fixint.h"
 
 #include <vector>
@@ -69,6 +70,10 @@ class Plaintext
 
   int degree() const;
 
+  // resize with storage from ElementPool if needed
+  void resize_evaluation() const;
+  void resize_polynomial() const;
+
   public:
   
   const FD& get_field() const { return *Field_Data; }
@@ -84,6 +89,15 @@ class Plaintext
   /// Initialization
   Plaintext(const FHE_Params& params);
 
+  /* The storage is kept in ElementPool when not in use */
+  Plaintext(const Plaintext& other) : Field_Data(other.Field_Data)
+  { *this = other; }
+  Plaintext(Plaintext&& other) = default;
+  ~Plaintext() { ElementPool<T>::give(a); ElementPool<S>::give(b); }
+
+  Plaintext& operator=(const Plaintext& other);
+  Plaintext& operator=(Plaintext&& other);
+
   void allocate(PT_Type type) const;
   void allocate() const { allocate(type); }
   void allocate_slots(const bigint& value);
@@ -107,7 +121,7 @@ class Plaintext
   void set_element(int i,const T& e)
     { if (type==Polynomial)
         { throw not_implemented(); }
-      a.resize(num_slots());
+      resize_evaluation();
       a[i]=e;
       type=Evaluation;
     }
@@ -131,7 +145,7 @@ class Plaintext
   // Assumes v is of the correct length (phi_m) for the given ring
   // and is already reduced modulo the correct prime etc
   void set_poly(const vector<S>& v)
-    { type=Polynomial; b=v; }
+    { type=Polynomial; ElementPool<S>::reserve(b, v.size()); b=v; }
   const vector<S>& get_poly() const
     {
       to_poly();
@@ -184,6 +198,8 @@ class Plaintext
   Plaintext& operator+=(const Plaintext& y);
   Plaintext& operator-=(const Plaintext& y)
   { to_poly(); y.to_poly(); ::sub(*this, *this, y); return *this; }
+  Plaintext& operator*=(const Plaintext& y)
+  { mul(*this, y); return *this; }
 
   void negate();
 
@@ -34,6 +34,43 @@ Ring_Element::Ring_Element(const FFT_Data& fftd,RepType r)
 }
 
 
+Ring_Element::Ring_Element(const Ring_Element& other) :
+    rep(other.rep), FFTD(other.FFTD)
+{
+  *this = other;
+}
+
+
+Ring_Element& Ring_Element::operator=(const Ring_Element& other)
+{
+  if (this == &other)
+    return *this;
+  rep = other.rep;
+  FFTD = other.FFTD;
+  if (element.capacity() < other.element.size())
+    ElementPool<modp>::take(element, other.element.size());
+  element = other.element;
+  return *this;
+}
+
+
+Ring_Element& Ring_Element::operator=(Ring_Element&& other)
+{
+  // other returns the old storage to the pool
+  rep = other.rep;
+  FFTD = other.FFTD;
+  element.swap(other.element);
+  return *this;
+}
+
+
+void Ring_Element::reserve()
+{
+  assert(FFTD);
+  ElementPool<modp>::reserve(element, FFTD->phi_m());
+}
+
+
 void Ring_Element::prepare(const Ring_Element& other)
 {
   assert(this != &other);
@@ -45,14 +82,13 @@ void Ring_Element::prepare(const Ring_Element& other)
 void Ring_Element::prepare_push()
 {
   element.clear();
-  assert(FFTD);
-  element.reserve(FFTD->phi_m());
+  reserve();
 }
 
 
 void Ring_Element::allocate()
 {
-  assert(FFTD);
+  reserve();
   element.resize(FFTD->phi_m());
 }
 
@@ -385,7 +421,10 @@ void Ring_Element::change_rep(RepType r)
     { rep=evaluation;
       if ((*FFTD).get_twop()==0)
         { // m a power of two variant
-          FFT_Iter2(element,(*FFTD).phi_m(),(*FFTD).get_roots(),(*FFTD).get_prD());
+          if ((*FFTD).get_ntt(0).active())
+            (*FFTD).get_ntt(0).apply(element);
+          else
+            FFT_Iter2(element,(*FFTD).phi_m(),(*FFTD).get_roots(),(*FFTD).get_prD());
 	}
       else
         { // Non m power of two variant and FFT enabled
@@ -396,14 +435,18 @@ void Ring_Element::change_rep(RepType r)
     { rep=polynomial;
       if ((*FFTD).get_twop()==0)
 	{ // m a power of two variant
-          modp root2;
-          Sqr(root2,(*FFTD).get_root(1),(*FFTD).get_prD());
-          FFT_Iter(element, (*FFTD).phi_m(),root2,(*FFTD).get_prD());
-          modp w;
-          w = (*FFTD).get_iphi();
-          for (int i=0; i<(*FFTD).phi_m(); i++)
-            { Mul(element[i], element[i], w, (*FFTD).get_prD());
-              Mul(w, w, (*FFTD).get_root(1),(*FFTD).get_prD());
+          if ((*FFTD).get_ntt(1).active())
+            (*FFTD).get_ntt(1).apply(element);
+          else
+            { modp root2;
+              Sqr(root2,(*FFTD).get_root(1),(*FFTD).get_prD());
+              FFT_Iter(element, (*FFTD).phi_m(),root2,(*FFTD).get_prD());
+              modp w;
+              w = (*FFTD).get_iphi();
+              for (int i=0; i<(*FFTD).phi_m(); i++)
+                { Mul(element[i], element[i], w, (*FFTD).get_prD());
+                  Mul(w, w, (*FFTD).get_root(1),(*FFTD).get_prD());
+                }
             }
         }
       else
@@ -549,6 +592,7 @@ void Ring_Element::unpack(octetStream& o)
   o.get(a);
   rep=(RepType) a;
   check_rep();
+  prepare_push();
   get(o,element,(*FFTD).get_prD());
   check_size();
 }
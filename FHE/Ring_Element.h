@@ -15,6 +15,7 @@
 enum RepType { polynomial, evaluation };
 
 #include "FHE/FFT_Data.h"
+#include "FHE/ElementPool.h"
 #include "Tools/octetStream.h"
 #include "Tools/random.h"
 #include <FHE/Generator.h>
@@ -43,17 +44,28 @@ class Ring_Element
 
   vector<modp> element; 
 
+  // storage for phi_m() elements from the pool if needed
+  void reserve();
+
+  public:
+
   /* Careful calling this one, as FFTD will not be defined */
   Ring_Element(RepType r=polynomial) : FFTD(0) { rep=r; }
 
-  public:
+  /* The coefficients are kept in ElementPool when not in use */
+  Ring_Element(const Ring_Element& other);
+  Ring_Element(Ring_Element&& other) = default;
+  ~Ring_Element() { ElementPool<modp>::give(element); }
+
+  Ring_Element& operator=(const Ring_Element& other);
+  Ring_Element& operator=(Ring_Element&& other);
 
   // Used to basically make sure *this is able to cope
   // with being assigned to by something of "type" e
   void partial_assign(const Ring_Element& e)
     { rep=e.rep; FFTD=e.FFTD; 
       if (FFTD)
-        element.resize((*FFTD).phi_m());
+        allocate();
     }
 
   void prepare(const Ring_Element& e);
@@ -76,6 +88,7 @@ class Ring_Element
       assert(size_t(prd.num_slots()) == other.size());
       FFTD = &prd;
       rep = r;
+      prepare_push();
       for (auto& x : other)
         element.push_back({x, FFTD->get_prD()});
     }
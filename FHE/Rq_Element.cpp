@@ -254,9 +254,9 @@ void Rq_Element::Scale(const bigint& p)
       }
   }
 
-  // Now add delta back onto a0
-  Rq_Element bb(b0,b1);
-  ::add(*this,*this,bb);
+  // Now add delta back onto a0, avoiding copies of b0 and b1
+  add(a[0],a[0],b0);
+  add(a[1],a[1],b1);
 
   // Now divide by p1 mod p0
   modp p1_inv,pp;
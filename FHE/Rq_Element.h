@@ -18,6 +18,7 @@
 #include "FHE/tools.h"
 #include "FHE/Generator.h"
 #include "Plaintext.h"
+#include "Tools/FixedVector.h"
 #include <vector>
 
 // Forward declare the friend functions
@@ -30,12 +31,17 @@ void mul(Rq_Element& ans,const Rq_Element& a,const bigint& b);
 class Rq_Element
 {
 protected:
-  vector<Ring_Element> a;
+  // at most two components, without allocation on copy
+  FixedVector<Ring_Element, 2> a;
   int lev;
 
   // Must be careful not to call by mistake
-  Rq_Element(RepType r0=evaluation,RepType r1=polynomial) :
-    a({r0, r1}), lev(n_mults()) {}
+  Rq_Element(RepType r0=evaluation,RepType r1=polynomial)
+  {
+    a.push_back(r0);
+    a.push_back(r1);
+    lev = n_mults();
+  }
 
   public:
   
@@ -62,14 +68,19 @@ protected:
 
   Rq_Element(const FHE_PK& pk);
 
-  Rq_Element(const Ring_Element& b0,const Ring_Element& b1) :
-    a({b0, b1}), lev(n_mults())
+  Rq_Element(const Ring_Element& b0,const Ring_Element& b1)
   {
     assert(b0.get_FFTD().get_R() == b1.get_FFTD().get_R());
+    a.push_back(b0);
+    a.push_back(b1);
+    lev = n_mults();
   }
 
-  Rq_Element(const Ring_Element& b0) :
-    a({b0}), lev(n_mults()) {}
+  Rq_Element(const Ring_Element& b0)
+  {
+    a.push_back(b0);
+    lev = n_mults();
+  }
 
   template<class T, class FD, class S>
   Rq_Element(const FHE_Params& params, const Plaintext<T, FD, S>& plaintext,
@@ -15,10 +15,109 @@
 #include "PairwiseMachine.h"
 
 #include <iostream>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 using namespace std;
 
 #include "Protocols/fake-stuff.hpp"
 
+namespace
+{
+
+// increase when changing the format of anything in setup files
+const int SETUP_FILE_VERSION = 1;
+const char SETUP_FILE_MAGIC[] = "MP-SPDZ FHE setup";
+
+struct SetupFileHeader
+{
+  char magic[sizeof(SETUP_FILE_MAGIC)];
+  int version;
+  int modp_size;
+  size_t length;
+  octet hash[crypto_generichash_BYTES];
+
+  SetupFileHeader() :
+      version(SETUP_FILE_VERSION), modp_size(sizeof(modp)), length(0)
+  {
+    memcpy(magic, SETUP_FILE_MAGIC, sizeof(magic));
+    memset(hash, 0, sizeof(hash));
+  }
+};
+
+}
+
+void write_setup_file(const string& filename, const octetStream& os)
+{
+  SetupFileHeader header;
+  header.length = os.get_length();
+  crypto_generichash(header.hash, sizeof(header.hash), os.get_data(),
+      os.get_length(), 0, 0);
+
+  string tmp = filename + ".tmp";
+  ofstream file(tmp, ios::binary);
+  file.write((char*) &header, sizeof(header));
+  file.write((char*) os.get_data(), os.get_length());
+  file.close();
+  if (file.fail() or rename(tmp.c_str(), filename.c_str()) != 0)
+    throw file_error("cannot write setup to " + filename);
+}
+
+void read_setup_file(const string& filename, octetStream& os)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw file_error("cannot read from " + filename);
+
+  struct stat buf;
+  void* mapped = MAP_FAILED;
+  if (fstat(fd, &buf) == 0 and buf.st_size > 0)
+    mapped = mmap(0, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+    throw file_error("cannot map " + filename);
+
+  string error;
+  SetupFileHeader expected, header;
+  auto content = (octet*) mapped + sizeof(header);
+  if (size_t(buf.st_size) < sizeof(header))
+    error = "file too short";
+  else
+    {
+      memcpy(&header, mapped, sizeof(header));
+      if (memcmp(header.magic, expected.magic, sizeof(header.magic)))
+        error = "not a setup file";
+      else if (header.version != expected.version)
+        error = "format version " + to_string(header.version)
+            + " instead of " + to_string(expected.version);
+      else if (header.modp_size != expected.modp_size)
+        error = "modp size " + to_string(header.modp_size) + " instead of "
+            + to_string(expected.modp_size);
+      else if (header.length != buf.st_size - sizeof(header))
+        error = "wrong length";
+      else
+        {
+          crypto_generichash(expected.hash, sizeof(expected.hash), content,
+              header.length, 0, 0);
+          if (memcmp(header.hash, expected.hash, sizeof(header.hash)))
+            error = "hash mismatch";
+        }
+    }
+
+  if (error.empty())
+    {
+      os.reset_write_head();
+      os.append(content, header.length);
+    }
+
+  munmap(mapped, buf.st_size);
+
+  if (not error.empty())
+    throw file_error(filename + ": " + error);
+}
+
 template <class FD>
 PartSetup<FD>::PartSetup() :
     pk(params, 0), sk(params, 0), calpha(params)
@@ -220,7 +319,7 @@ void PartSetup<FD>::check(Player& P, MachineBase& machine)
     FieldD.hash(os);
     pk.pack(os);
     calpha.pack(os);
-    bundle.compare(P);
+    bundle.compare_hash(P);
 }
 
 template<class FD>
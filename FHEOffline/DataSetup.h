@@ -16,6 +16,16 @@ class DataSetup;
 class MachineBase;
 class MultiplicativeMachine;
 
+/*
+ * Setup files (parameters and keys) start with a header holding the
+ * format version, the modp size, the content length, and a hash of the
+ * content. Reading goes through a memory mapping and throws if any of
+ * these does not match, so stale or damaged files lead to regeneration.
+ * Writing goes via a temporary file to avoid leaving partial files.
+ */
+void write_setup_file(const string& filename, const octetStream& os);
+void read_setup_file(const string& filename, octetStream& os);
+
 template <class FD>
 class PartSetup
 {
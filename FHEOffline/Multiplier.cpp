@@ -6,9 +6,39 @@
 #include <FHEOffline/Multiplier.h>
 #include "FHEOffline/PairwiseGenerator.h"
 #include "FHEOffline/PairwiseMachine.h"
+#include "Processor/BaseMachine.h"
 
 #include "Math/modp.hpp"
 
+template <class FD>
+MultiplierJob<FD>::MultiplierJob(const FHE_PK& pk, const FD& FieldD) :
+        pk(pk), enc_a(0), b(0), C(pk), product_share(FieldD)
+{
+    product_share.allocate_slots(pk.p() << 64);
+}
+
+template <class FD>
+int MultiplierJob<FD>::run()
+{
+    // not an online thread, so no FFT jobs for other threads
+    BaseMachine::thread_num = -1;
+
+    timers["Ciphertext multiplication"].start();
+    C.mul(*enc_a, *b);
+    timers["Ciphertext multiplication"].stop();
+
+    PRNG G;
+    G.ReSeed();
+    timers["Mask randomization"].start();
+    product_share.randomize(G);
+    C.rerandomize(pk);
+    timers["Mask randomization"].stop();
+    C += product_share;
+    o.reset_write_head();
+    C.pack(o);
+    return 0;
+}
+
 template <class FD>
 Multiplier<FD>::Multiplier(int offset, PairwiseGenerator<FD>& generator) :
         Multiplier(offset, generator.machine, generator.P, generator.timers)
@@ -27,11 +57,24 @@ Multiplier<FD>::Multiplier(int offset, PairwiseMachine& machine, Player& P,
     timers(timers),
     C(machine.pk), mask(machine.pk),
     product_share(machine.setup<FD>().FieldD), rc(machine.pk),
-    volatile_capacity(0)
+    volatile_capacity(0), worker(0)
 {
     product_share.allocate_slots(machine.pk.p() << 64);
 }
 
+template <class FD>
+Multiplier<FD>::~Multiplier()
+{
+    for (size_t i = 0; i < pending.size(); i++)
+        worker->done();
+    if (worker)
+        delete worker;
+    for (auto job : pending)
+        delete job;
+    for (auto job : idle)
+        delete job;
+}
+
 template <class FD>
 void Multiplier<FD>::multiply_and_add(Plaintext_<FD>& res,
         const Ciphertext& enc_a, const Plaintext_<FD>& b)
@@ -120,11 +163,74 @@ void Multiplier<FD>::multiply_alpha_and_add(Plaintext_<FD>& res,
     multiply_and_add(res, other_enc_alpha, b, role);
 }
 
+template <class FD>
+void Multiplier<FD>::start_alpha(const Rq_Element& b)
+{
+    if (not worker)
+        worker = new Worker<MultiplierJob<FD>>;
+
+    MultiplierJob<FD>* job;
+    if (idle.empty())
+        job = new MultiplierJob<FD>(other_pk, machine.setup<FD>().FieldD);
+    else
+    {
+        job = idle.back();
+        idle.pop_back();
+    }
+
+    job->enc_a = &other_enc_alpha;
+    job->b = &b;
+    pending.push_back(job);
+    worker->request(*job);
+}
+
+template <class FD>
+void Multiplier<FD>::finish(Plaintext_<FD>& res)
+{
+    CODE_LOCATION
+    assert(not pending.empty());
+    auto job = pending.front();
+    pending.pop_front();
+
+    timers["Waiting for worker"].start();
+    worker->done();
+    timers["Waiting for worker"].stop();
+    for (auto& x : job->timers)
+    {
+        timers[x.first] += x.second;
+        x.second.reset();
+    }
+
+    res -= job->product_share;
+
+    timers["Multiplied ciphertext sending"].start();
+    P.reverse_exchange(job->o);
+    timers["Multiplied ciphertext sending"].stop();
+
+    timers["Decryption"].start();
+    C.unpack(job->o);
+    machine.sk.decrypt_any(product_share, C);
+    res += product_share;
+    timers["Decryption"].stop();
+
+    idle.push_back(job);
+
+    memory_usage.update("multiplied ciphertext", C.report_size(CAPACITY));
+    memory_usage.update("pipelined ciphertexts",
+            (pending.size() + idle.size()) * job->C.report_size(CAPACITY));
+    memory_usage.update("product shares", product_share.report_size(CAPACITY));
+}
+
 template <class FD>
 size_t Multiplier<FD>::report_size(ReportType type)
 {
-    return C.report_size(type) + mask.report_size(type)
+    size_t res = C.report_size(type) + mask.report_size(type)
             + product_share.report_size(type) + rc.report_size(type);
+    for (auto job : pending)
+        res += job->C.report_size(type) + job->product_share.report_size(type);
+    for (auto job : idle)
+        res += job->C.report_size(type) + job->product_share.report_size(type);
+    return res;
 }
 
 template <class FD>
@@ -142,5 +248,7 @@ const vector<Ciphertext>& Multiplier<FD>::get_multiplicands(
 }
 
 
+template class MultiplierJob<FFT_Data>;
+template class MultiplierJob<P2Data>;
 template class Multiplier<FFT_Data>;
 template class Multiplier<P2Data>;
@@ -9,8 +9,11 @@
 #include "FHEOffline/SimpleEncCommit.h"
 #include "FHE/AddableVector.h"
 #include "Tools/MemoryUsage.h"
+#include "Tools/Worker.h"
 #include "OT/BaseOT.h"
 
+#include <deque>
+
 template <class FD>
 using PlaintextVector = AddableVector< Plaintext_<FD> >;
 
@@ -18,6 +21,26 @@ template <class FD>
 class PairwiseGenerator;
 class PairwiseMachine;
 
+// local part of the sender side, run by a worker thread
+template <class FD>
+class MultiplierJob
+{
+    const FHE_PK& pk;
+
+public:
+    const Ciphertext* enc_a;
+    const Rq_Element* b;
+
+    Ciphertext C;
+    Plaintext_<FD> product_share;
+    octetStream o;
+    map<string, Timer> timers;
+
+    MultiplierJob(const FHE_PK& pk, const FD& FieldD);
+
+    int run();
+};
+
 template <class FD>
 class Multiplier
 {
@@ -38,10 +61,16 @@ class Multiplier
 
     octetStream o;
 
+    // pipeline
+    Worker<MultiplierJob<FD>>* worker;
+    deque<MultiplierJob<FD>*> pending;
+    vector<MultiplierJob<FD>*> idle;
+
 public:
     Multiplier(int offset, PairwiseGenerator<FD>& generator);
     Multiplier(int offset, PairwiseMachine& machine, Player& P,
             map<string, Timer>& timers);
+    ~Multiplier();
 
     void multiply_and_add(Plaintext_<FD>& res, const Ciphertext& C,
             const Plaintext_<FD>& b);
@@ -51,6 +80,14 @@ public:
             int n_summands = 1);
     void multiply_alpha_and_add(Plaintext_<FD>& res, const Rq_Element& b,
             OT_ROLE role = BOTH);
+
+    // Pipelined version of multiply_alpha_and_add():
+    // start() queues the local work for the worker thread,
+    // and finish() exchanges and decrypts in the same order.
+    // b has to remain unchanged until the respective finish().
+    void start_alpha(const Rq_Element& b);
+    void finish(Plaintext_<FD>& res);
+
     int get_offset() { return P.get_offset(); }
     size_t report_size(ReportType type);
     void report_size(ReportType type, MemoryUsage& res);
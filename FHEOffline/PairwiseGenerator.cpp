@@ -77,9 +77,34 @@ void PairwiseGenerator<FD>::run()
         timers["Proof exchange"].stop();
         volatile_memory = max(prover_memory, verifier_memory);
 
-        Rq_Element values({machine.setup<FD>().params, evaluation, evaluation});
+        // the multipliers' worker threads prepare the next triple
+        // while the current one is exchanged and sacrificed
+        vector<Rq_Element> values(6,
+                {machine.setup<FD>().params, evaluation, evaluation});
+        auto start = [&](int k)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                Rq_Element* multiplicand = &b_mod_q[k];
+                if (j != 1)
+                {
+                    multiplicand = &values[3 * (k % 2) + j];
+                    timers["Plaintext conversion"].start();
+                    multiplicand->from((j == 0 ? a : c)[k].get_iterator());
+                    timers["Plaintext conversion"].stop();
+                }
+
+                for (auto m : multipliers)
+                    m->start_alpha(*multiplicand);
+            }
+        };
+
+        start(0);
         for (int k = 0; k < n_ciphertexts; k++)
         {
+            if (k + 1 < n_ciphertexts)
+                start(k + 1);
+
             producer.ai = a[k];
             producer.bi = b[k];
             producer.ci = c[k];
@@ -90,17 +115,8 @@ void PairwiseGenerator<FD>::run()
                 producer.macs[j].mul(machine.setup<FD>().alpha, producer.values[j]);
                 timers["Plaintext multiplication"].stop();
 
-                if (j == 1)
-                    values = b_mod_q[k];
-                else
-                {
-                    timers["Plaintext conversion"].start();
-                    values.from(producer.values[j].get_iterator());
-                    timers["Plaintext conversion"].stop();
-                }
-
                 for (auto m : multipliers)
-                    m->multiply_alpha_and_add(producer.macs[j], values);
+                    m->finish(producer.macs[j]);
             }
             producer.reset();
             total += producer.sacrifice(P, MC);
@@ -111,6 +127,8 @@ void PairwiseGenerator<FD>::run()
         timers["Checking"].stop();
     }
 
+    pool_memory = max(pool_memory, ElementPoolBase::report_size());
+
 #ifdef FHE_MEMORY
     cerr << "Could save " << 1e-9 * a.report_size(CAPACITY) << " GB" << endl;
 #endif
@@ -171,6 +189,7 @@ size_t PairwiseGenerator<FD>::report_size(ReportType type)
     res += ciphertexts.get_max_length() + cleartexts.get_max_length();
     res += EC.report_size(type) + EC.volatile_memory;
     res += b_mod_q.report_size(type);
+    res += pool_memory;
     return res;
 }
 
@@ -192,6 +211,7 @@ void PairwiseGenerator<FD>::report_size(ReportType type, MemoryUsage& res)
     res.add("serialized cleartexts", cleartexts.get_max_length());
     res.add("generator volatile", volatile_memory);
     res.add("b mod p", b_mod_q.report_size(type));
+    res.add("element pools", pool_memory);
     res += EC.memory_usage;
 }
 
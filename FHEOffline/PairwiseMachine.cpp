@@ -158,7 +158,7 @@ void PairwiseMachine::check(Player& P) const
     {
     }
 
-    bundle.compare(P);
+    bundle.compare_hash(P);
 }
 
 template void RealPairwiseMachine::setup_keys<FFT_Data>();
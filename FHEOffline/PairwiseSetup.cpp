@@ -10,6 +10,7 @@
 #include "FHEOffline/Proof.h"
 #include "FHEOffline/PairwiseMachine.h"
 #include "FHEOffline/TemiSetup.h"
+#include "FHEOffline/DataSetup.h"
 #include "Tools/Commit.h"
 #include "Tools/Bundle.h"
 #include "Processor/OnlineOptions.h"
@@ -81,7 +82,7 @@ void secure_init(T& setup, Player& P, U& machine,
     try
     {
         octetStream os;
-        os.input(filename);
+        read_setup_file(filename, os);
         os.get(machine.extra_slack);
         setup.unpack(os);
     }
@@ -117,8 +118,7 @@ void secure_init(T& setup, Player& P, U& machine,
         octetStream os;
         os.store(machine.extra_slack);
         setup.pack(os);
-        ofstream file(filename);
-        os.output(file);
+        write_setup_file(filename, os);
     }
 
     if (OnlineOptions::singleton.verbose)
@@ -168,7 +168,7 @@ void PairwiseSetup<FD>::check(Player& P, PairwiseMachine& machine)
     bundle.mine.store(machine.extra_slack);
     params.pack(bundle.mine);
     FieldD.hash(bundle.mine);
-    bundle.compare(P);
+    bundle.compare_hash(P);
 }
 
 template <class FD>
@@ -12,9 +12,19 @@
 #include "SimpleEncCommit.h"
 #include "SimpleMachine.h"
 #include "Tools/mkpath.h"
+#include "Processor/BaseMachine.h"
 
 #include "Protocols/Share.hpp"
 
+int CiphertextMultiplication::run()
+{
+  // not an online thread, so no FFT jobs for other threads
+  BaseMachine::thread_num = -1;
+  mul(ans, c0, c1, pk);
+  pool_memory = ElementPoolBase::report_size();
+  return 0;
+}
+
 template<class FD>
 Producer<FD>::Producer(int output_thread, bool write_output) :
     n_slots(0), output_thread(output_thread), write_output(write_output),
@@ -26,7 +36,8 @@ template <class T, class FD, class S>
 TripleProducer<T, FD, S>::TripleProducer(const FD& FieldD,
     int my_num, int output_thread, bool write_output, string dir) :
     Producer<FD>(output_thread, write_output),
-    i(FieldD.num_slots()), values{ FieldD, FieldD, FieldD },
+    i(FieldD.num_slots()), worker(0), worker_pool_memory(0),
+    values{ FieldD, FieldD, FieldD },
     macs{ FieldD, FieldD, FieldD }, ai(values[0]), bi(values[1]),
     ci(values[2]), gam_ai(macs[0]), gam_bi(macs[1]), gam_ci(macs[2])
 {
@@ -41,6 +52,13 @@ TripleProducer<T, FD, S>::TripleProducer(const FD& FieldD,
       this->clear_file(my_num, output_thread, false);
 }
 
+template <class T, class FD, class S>
+TripleProducer<T, FD, S>::~TripleProducer()
+{
+  if (worker)
+    delete worker;
+}
+
 template <class FD>
 TupleProducer<FD>::TupleProducer(const FD& FieldD,
     int output_thread, bool write_output) :
@@ -120,8 +138,18 @@ void TripleProducer<T, FD, S>::run(const Player& P, const FHE_PK& pk,
   EC.next(bi,cb);
   timers["Committing"].stop();
 
-  // Steps e and f
+  // Step g for a and b in the background
+  if (not worker)
+    worker = new Worker<CiphertextMultiplication>;
   Ciphertext cab(params),cc(params);
+  Ciphertext cgam_a(params),cgam_b(params),cgam_c(params);
+  CiphertextMultiplication mul_a(cgam_a, calpha, ca, pk),
+      mul_b(cgam_b, calpha, cb, pk), mul_c(cgam_c, calpha, cc, pk);
+  PendingMultiplications pending(*worker);
+  pending.request(mul_a);
+  pending.request(mul_b);
+
+  // Steps e and f
   timers["Multiplying"].start();
   mul(cab,ca,cb,pk);
   timers["Multiplying"].stop();
@@ -129,21 +157,26 @@ void TripleProducer<T, FD, S>::run(const Player& P, const FHE_PK& pk,
   Reshare(ci,cc,cab,true,P,EC,pk,dd);
   timers["Resharing"].stop();
 
-  // Step g
-  Ciphertext cgam_a(params),cgam_b(params),cgam_c(params);
-  timers["Multiplying"].start();
-  mul(cgam_a,calpha,ca,pk);    
-  mul(cgam_b,calpha,cb,pk);    
-  mul(cgam_c,calpha,cc,pk);    
-  timers["Multiplying"].stop();
+  // Step g for c in the background
+  pending.request(mul_c);
 
   // Step h
+  timers["Multiplying"].start();
+  pending.wait();
+  pending.wait();
+  timers["Multiplying"].stop();
   timers["Decrypting"].start();
   dd.reshare(gam_ai,cgam_a,EC);
   dd.reshare(gam_bi,cgam_b,EC);
+  timers["Decrypting"].stop();
+  timers["Multiplying"].start();
+  pending.wait();
+  timers["Multiplying"].stop();
+  timers["Decrypting"].start();
   dd.reshare(gam_ci,cgam_c,EC);
   timers["Decrypting"].stop();
 
+  worker_pool_memory = max(worker_pool_memory, mul_c.pool_memory);
   reset();
 }
 
@@ -297,7 +330,7 @@ size_t TripleProducer<T, FD, S>::report_size(ReportType type)
 {
     return ai.report_size(type) + bi.report_size(type) + ci.report_size(type)
             + gam_ai.report_size(type) + gam_bi.report_size(type)
-            + gam_ci.report_size(type);
+            + gam_ci.report_size(type) + worker_pool_memory;
 }
 
 template <class FD>
@@ -13,6 +13,7 @@
 #include "FHEOffline/Sacrificing.h"
 #include "Protocols/Share.h"
 #include "Math/Setup.h"
+#include "Tools/Worker.h"
 
 template <class T>
 string prep_filename(string type, int my_num, int thread_num,
@@ -55,11 +56,67 @@ public:
   virtual size_t report_size(ReportType type) { (void)type; return 0; }
 };
 
+// homomorphic multiplication on a worker thread
+class CiphertextMultiplication
+{
+  Ciphertext& ans;
+  const Ciphertext &c0, &c1;
+  const FHE_PK& pk;
+
+public:
+  // memory in the element pools of the worker thread
+  size_t pool_memory;
+
+  CiphertextMultiplication(Ciphertext& ans, const Ciphertext& c0,
+      const Ciphertext& c1, const FHE_PK& pk) :
+      ans(ans), c0(c0), c1(c1), pk(pk), pool_memory(0)
+  {
+  }
+
+  int run();
+};
+
+// waits for all requested multiplications when leaving the scope,
+// also by exception, because the jobs refer to local variables
+class PendingMultiplications
+{
+  Worker<CiphertextMultiplication>& worker;
+  int n_pending;
+
+public:
+  PendingMultiplications(Worker<CiphertextMultiplication>& worker) :
+      worker(worker), n_pending(0)
+  {
+  }
+
+  ~PendingMultiplications()
+  {
+    while (n_pending > 0)
+      wait();
+  }
+
+  void request(CiphertextMultiplication& job)
+  {
+    worker.request(job);
+    n_pending++;
+  }
+
+  void wait()
+  {
+    n_pending--;
+    worker.done();
+  }
+};
+
 template <class T, class FD, class S>
 class TripleProducer : public TripleSacriFactory< Share<T> >, public Producer<FD>
 {
   unsigned int i;
 
+  // MAC multiplications overlap with communication
+  Worker<CiphertextMultiplication>* worker;
+  size_t worker_pool_memory;
+
 public:
   Plaintext_<FD> values[3], macs[3];
   Plaintext<T,FD,S> &ai, &bi, &ci;
@@ -69,6 +126,7 @@ public:
 
   TripleProducer(const FD& Field, int my_num, int output_thread = 0,
       bool write_output = true, string dir = PREP_DIR);
+  ~TripleProducer();
 
   void clear() { this->triples.clear(); }
   void run(const Player& P, const FHE_PK& pk,
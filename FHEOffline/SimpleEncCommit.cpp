@@ -85,8 +85,8 @@ void SimpleEncCommitFactory<FD>::next(Plaintext_<FD>& mess, Ciphertext& C)
 
     if (get_proof().use_top_gear(pk))
     {
-        mess = mess + mess;
-        C = C + C;
+        mess += mess;
+        C += C;
     }
 
     cnt--;
@@ -69,6 +69,7 @@ void SimpleGenerator<T,FD>::run(bool exhaust)
         total += producer->num_slots();
     }
     MC.Check(P);
+    pool_memory = max(pool_memory, ElementPoolBase::report_size());
     timer.stop();
     timers["Thread"] = timer;
     timers.insert(producer->timers.begin(), producer->timers.end());
@@ -80,7 +81,7 @@ size_t SimpleGenerator<T,FD>::report_size(ReportType type)
 {
     return EC.report_size(type) + EC.get_volatile()
             + producer->report_size(type) + dd.report_size(type)
-            + volatile_memory;
+            + volatile_memory + pool_memory;
 }
 
 template <template <class> class T, class FD>
@@ -90,6 +91,7 @@ void SimpleGenerator<T,FD>::report_size(ReportType type, MemoryUsage& res)
     res.add("producer", producer->report_size(type));
     res.add("generator volatile", volatile_memory);
     res.add("distributed decryption", dd.report_size(type));
+    res.add("element pools", pool_memory);
 }
 
 template class SimpleGenerator<SimpleEncCommit_, FFT_Data>;
@@ -30,10 +30,14 @@ public:
 
     map<string, Timer> timers;
 
+    // memory in the element pools of the generator thread
+    size_t pool_memory;
+
     GeneratorBase(int thread_num, const Names& N, Player* player = 0) :
             player(player ? 0 : new PlainPlayer(N, to_string(thread_num))),
             thread_num(thread_num),
-            P(player ? *player : *this->player), thread(0), total(0)
+            P(player ? *player : *this->player), thread(0), total(0),
+            pool_memory(0)
     {
     }
     virtual ~GeneratorBase()
@@ -0,0 +1,28 @@
+/*
+ * PPMLAC-offline.cpp
+ *
+ */
+
+#include "Protocols/PPMLAC_share.h"
+
+#include "Processor/OnlineMachine.hpp"
+#include "Processor/OfflineMachine.hpp"
+#include "Processor/Machine.hpp"
+#include "Processor/OnlineOptions.hpp"
+#include "Protocols/Replicated.hpp"
+#include "Protocols/MalRepRingPrep.hpp"
+#include "Protocols/ReplicatedPrep.hpp"
+#include "Protocols/MAC_Check_Base.hpp"
+#include "Math/gfp.hpp"
+#include "Math/Z2k.hpp"
+
+int main(int argc, const char** argv)
+{
+    ez::ezOptionParser opt;
+    OnlineOptions::singleton = {opt, argc, argv, PPMLACShare<gf2n>()};
+    // writes the multiplication masks for a program to Player-Data
+    // to be used by PPMLAC-party.x with -F
+    OfflineMachine<DishonestMajorityMachine> machine(argc, argv, opt,
+            OnlineOptions::singleton, gf2n());
+    machine.run<PPMLACShare<gfp_<0, 2>>, PPMLACShare<gf2n>>();
+}
@@ -0,0 +1,22 @@
+/*
+ * PPMLAC-ring-party.cpp
+ *
+ */
+
+#include "Protocols/PPMLAC_share.h"
+
+#include "Processor/RingMachine.hpp"
+#include "Processor/Machine.hpp"
+#include "Protocols/Replicated.hpp"
+#include "Protocols/MalRepRingPrep.hpp"
+#include "Protocols/ReplicatedPrep.hpp"
+#include "Protocols/MAC_Check_Base.hpp"
+#include "Math/gfp.hpp"
+#include "Math/Z2k.hpp"
+
+int main(int argc, const char** argv)
+{
+    ez::ezOptionParser opt;
+    // 64-bit by default, other ring sizes with -R
+    DishonestMajorityRingMachine<PPMLACRingShare, PPMLACShare>(argc, argv, opt);
+}
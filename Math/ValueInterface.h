@@ -39,6 +39,15 @@ public:
 
     static bigint pr() { throw runtime_error("no prime modulus"); }
 
+    // elementwise multiplication, element i at z[i * z_step] etc.
+    template<class T, class U>
+    static void mul_batch(T* z, const T* x, const U* y, size_t n,
+            int z_step = 1, int x_step = 1, int y_step = 1)
+    {
+        for (size_t i = 0; i < n; i++)
+            z[i * z_step] = x[i * x_step] * y[i * y_step];
+    }
+
     void normalize() {}
 
     void randomize_part(PRNG&, int) { throw not_implemented(); }
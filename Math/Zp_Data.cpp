@@ -128,6 +128,412 @@ void Zp_Data::Mont_Mult_switch(mp_limb_t* z, const mp_limb_t* x,
   }
 }
 
+#ifdef __AVX512IFMA__
+
+/*
+ * Eight Montgomery multiplications at once with the 52-bit
+ * multiply-add instructions. The operands are split into 52-bit
+ * digits, one vector per digit (structure of arrays), and the
+ * reduction by R = 2^(64T) is done in steps of 52 bits and a final
+ * step of the remaining 12 (T = 1) or 24 bits (T = 2). The result is
+ * thus the same as with the limb-wise Montgomery multiplication.
+ */
+
+// Fix false warning about _mm512_undefined_epi32()
+#if __GNUC__ == 12
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace
+{
+
+const int IFMA_LANES = 8;
+const mp_limb_t MASK52 = (1ULL << 52) - 1;
+
+inline __m512i madd_lo(__m512i a, __m512i b, __m512i c)
+{
+  return _mm512_madd52lo_epu64(a, b, c);
+}
+
+inline __m512i madd_hi(__m512i a, __m512i b, __m512i c)
+{
+  return _mm512_madd52hi_epu64(a, b, c);
+}
+
+template<int T>
+inline void ifma_load(__m512i* res, const mp_limb_t* x, int step)
+{
+  if (step == 1 and T == 1)
+    res[0] = _mm512_loadu_si512(x);
+  else if (step == 2 and T == 2)
+    {
+      __m512i a = _mm512_loadu_si512(x), b = _mm512_loadu_si512(x + 8);
+      res[0] = _mm512_permutex2var_epi64(a,
+          _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14), b);
+      res[1] = _mm512_permutex2var_epi64(a,
+          _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15), b);
+    }
+  else
+    {
+      long long s = step;
+      __m512i index = _mm512_setr_epi64(0, s, 2 * s, 3 * s, 4 * s, 5 * s,
+          6 * s, 7 * s);
+      for (int j = 0; j < T; j++)
+        res[j] = _mm512_i64gather_epi64(index, x + j, 8);
+    }
+}
+
+template<int T>
+inline void ifma_store(mp_limb_t* z, int step, const __m512i* res)
+{
+  if (step == 1 and T == 1)
+    _mm512_storeu_si512(z, res[0]);
+  else if (step == 2 and T == 2)
+    {
+      _mm512_storeu_si512(z, _mm512_permutex2var_epi64(res[0],
+          _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), res[1]));
+      _mm512_storeu_si512(z + 8, _mm512_permutex2var_epi64(res[0],
+          _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), res[1]));
+    }
+  else
+    {
+      long long s = step;
+      __m512i index = _mm512_setr_epi64(0, s, 2 * s, 3 * s, 4 * s, 5 * s,
+          6 * s, 7 * s);
+      for (int j = 0; j < T; j++)
+        _mm512_i64scatter_epi64(z + j, index, res[j], 8);
+    }
+}
+
+// 64-bit limbs to 52-bit digits
+template<int T>
+inline void to_digits(__m512i* res, const __m512i* x)
+{
+  __m512i mask = _mm512_set1_epi64(MASK52);
+  res[0] = _mm512_and_si512(x[0], mask);
+  if (T == 1)
+    res[1] = _mm512_srli_epi64(x[0], 52);
+  else
+    {
+      res[1] = _mm512_and_si512(
+          _mm512_or_si512(_mm512_srli_epi64(x[0], 52),
+              _mm512_slli_epi64(x[1], 12)), mask);
+      res[2] = _mm512_srli_epi64(x[1], 40);
+    }
+}
+
+// z = x * y / 2^64 mod p for p < 2^64
+inline void mont_mult_ifma_1(__m512i* z, const __m512i* x, const __m512i* y,
+    const __m512i* p, __m512i pr, __m512i pi)
+{
+  __m512i zero = _mm512_setzero_si512();
+  __m512i xx[2], yy[2];
+  to_digits<1>(xx, x);
+  to_digits<1>(yy, y);
+
+  __m512i c0 = madd_lo(zero, xx[0], yy[0]);
+  __m512i c1 = madd_hi(zero, xx[0], yy[0]);
+  c1 = madd_lo(c1, xx[0], yy[1]);
+  c1 = madd_lo(c1, xx[1], yy[0]);
+  __m512i c2 = madd_hi(zero, xx[0], yy[1]);
+  c2 = madd_hi(c2, xx[1], yy[0]);
+  c2 = madd_lo(c2, xx[1], yy[1]);
+
+  // divide by 2^52
+  __m512i u = madd_lo(zero, c0, pi);
+  c0 = madd_lo(c0, u, p[0]);
+  c1 = madd_hi(c1, u, p[0]);
+  c1 = madd_lo(c1, u, p[1]);
+  c2 = madd_hi(c2, u, p[1]);
+  c1 = _mm512_add_epi64(c1, _mm512_srli_epi64(c0, 52));
+
+  // divide by 2^12
+  u = _mm512_and_si512(madd_lo(zero, c1, pi), _mm512_set1_epi64(0xfff));
+  c1 = madd_lo(c1, u, p[0]);
+  c2 = madd_hi(c2, u, p[0]);
+  c2 = madd_lo(c2, u, p[1]);
+
+  // c1 / 2^12 + c2 * 2^40 < 2p might need 65 bits
+  __m512i low = _mm512_srli_epi64(c1, 12);
+  __m512i r = _mm512_add_epi64(low, _mm512_slli_epi64(c2, 40));
+  __mmask8 reduce = _mm512_cmplt_epu64_mask(r, low)
+      | _mm512_cmpneq_epi64_mask(_mm512_srli_epi64(c2, 24), zero)
+      | _mm512_cmpge_epu64_mask(r, pr);
+  z[0] = _mm512_mask_sub_epi64(r, reduce, r, pr);
+}
+
+// z = x * y / 2^128 mod p for p < 2^128
+inline void mont_mult_ifma_2(__m512i* z, const __m512i* x, const __m512i* y,
+    const __m512i* p, const __m512i* pr, __m512i pi)
+{
+  __m512i zero = _mm512_setzero_si512();
+  __m512i xx[3], yy[3], c[6];
+  to_digits<2>(xx, x);
+  to_digits<2>(yy, y);
+
+  for (int i = 0; i < 6; i++)
+    c[i] = zero;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      {
+        c[i + j] = madd_lo(c[i + j], xx[i], yy[j]);
+        // product of top digits has at most 48 bits
+        if (i + j < 4)
+          c[i + j + 1] = madd_hi(c[i + j + 1], xx[i], yy[j]);
+      }
+
+  // divide by 2^104
+  for (int k = 0; k < 2; k++)
+    {
+      __m512i u = madd_lo(zero, c[k], pi);
+      for (int j = 0; j < 3; j++)
+        {
+          c[k + j] = madd_lo(c[k + j], u, p[j]);
+          c[k + j + 1] = madd_hi(c[k + j + 1], u, p[j]);
+        }
+      c[k + 1] = _mm512_add_epi64(c[k + 1], _mm512_srli_epi64(c[k], 52));
+    }
+
+  // divide by 2^24
+  __m512i u = _mm512_and_si512(madd_lo(zero, c[2], pi),
+      _mm512_set1_epi64(0xffffff));
+  for (int j = 0; j < 3; j++)
+    {
+      c[2 + j] = madd_lo(c[2 + j], u, p[j]);
+      if (j < 2)
+        c[3 + j] = madd_hi(c[3 + j], u, p[j]);
+    }
+
+  __m512i mask = _mm512_set1_epi64(MASK52);
+  for (int i = 2; i < 5; i++)
+    {
+      c[i + 1] = _mm512_add_epi64(c[i + 1], _mm512_srli_epi64(c[i], 52));
+      c[i] = _mm512_and_si512(c[i], mask);
+    }
+
+  // back to 64-bit limbs, r < 2p needs three
+  __m512i r0 = _mm512_or_si512(_mm512_srli_epi64(c[2], 24),
+      _mm512_slli_epi64(c[3], 28));
+  __m512i r1 = _mm512_or_si512(_mm512_srli_epi64(c[3], 36),
+      _mm512_slli_epi64(c[4], 16));
+  __m512i r2 = _mm512_or_si512(_mm512_srli_epi64(c[4], 48),
+      _mm512_slli_epi64(c[5], 4));
+
+  // r - p unless r < p
+  __mmask8 borrow0 = _mm512_cmplt_epu64_mask(r0, pr[0]);
+  __m512i d0 = _mm512_sub_epi64(r0, pr[0]);
+  __m512i d1 = _mm512_sub_epi64(r1, pr[1]);
+  __mmask8 borrow1 = _mm512_cmplt_epu64_mask(r1, pr[1])
+      | (borrow0 & _mm512_cmpeq_epi64_mask(r1, pr[1]));
+  d1 = _mm512_mask_sub_epi64(d1, borrow0, d1, _mm512_set1_epi64(1));
+  __mmask8 keep = borrow1 & _mm512_cmpeq_epi64_mask(r2, zero);
+  z[0] = _mm512_mask_blend_epi64(keep, d0, r0);
+  z[1] = _mm512_mask_blend_epi64(keep, d1, r1);
+}
+
+template<int T>
+size_t mont_mult_ifma(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+    size_t n, int z_step, int x_step, int y_step, const mp_limb_t* prA,
+    mp_limb_t pi)
+{
+  __m512i pr[T], p[T + 1];
+  for (int j = 0; j < T; j++)
+    pr[j] = _mm512_set1_epi64(prA[j]);
+  to_digits<T>(p, pr);
+  __m512i pi52 = _mm512_set1_epi64(pi & MASK52);
+
+  size_t i;
+  for (i = 0; i + IFMA_LANES <= n; i += IFMA_LANES)
+    {
+      __m512i xx[T], yy[T], zz[T];
+      ifma_load<T>(xx, x + i * x_step, x_step);
+      ifma_load<T>(yy, y + i * y_step, y_step);
+      if (T == 1)
+        mont_mult_ifma_1(zz, xx, yy, p, pr[0], pi52);
+      else
+        mont_mult_ifma_2(zz, xx, yy, p, pr, pi52);
+      ifma_store<T>(z + i * z_step, z_step, zz);
+    }
+  return i;
+}
+
+}
+
+#endif
+
+#ifdef __AVX2__
+
+/*
+ * Four Montgomery multiplications at once using 32-bit words in 64-bit
+ * lanes, which leaves enough room for a product plus two words.
+ * R = 2^(64T) is the same as with the limb-wise multiplication.
+ */
+
+namespace
+{
+
+const int AVX2_LANES = 4;
+
+template<int T>
+inline void avx2_load(__m256i* res, const mp_limb_t* x, int step)
+{
+  if (step == 1 and T == 1)
+    res[0] = _mm256_loadu_si256((const __m256i*) x);
+  else
+    {
+      long long s = step;
+      __m256i index = _mm256_setr_epi64x(0, s, 2 * s, 3 * s);
+      for (int j = 0; j < T; j++)
+        res[j] = _mm256_i64gather_epi64((const long long*) x + j, index, 8);
+    }
+}
+
+template<int T>
+inline void avx2_store(mp_limb_t* z, int step, const __m256i* res)
+{
+  if (step == 1 and T == 1)
+    _mm256_storeu_si256((__m256i*) z, res[0]);
+  else
+    {
+      mp_limb_t tmp[T][AVX2_LANES];
+      for (int j = 0; j < T; j++)
+        _mm256_storeu_si256((__m256i*) tmp[j], res[j]);
+      for (int i = 0; i < AVX2_LANES; i++)
+        for (int j = 0; j < T; j++)
+          z[i * step + j] = tmp[j][i];
+    }
+}
+
+template<int T>
+inline void to_words(__m256i* res, const __m256i* x)
+{
+  __m256i mask = _mm256_set1_epi64x(0xffffffff);
+  for (int j = 0; j < T; j++)
+    {
+      res[2 * j] = _mm256_and_si256(x[j], mask);
+      res[2 * j + 1] = _mm256_srli_epi64(x[j], 32);
+    }
+}
+
+template<int T>
+inline void mont_mult_avx2(__m256i* z, const __m256i* x, const __m256i* y,
+    const __m256i* p, __m256i pi)
+{
+  const int S = 2 * T;
+  __m256i mask = _mm256_set1_epi64x(0xffffffff);
+  __m256i xx[S], yy[S], a[S + 2], t, carry;
+  to_words<T>(xx, x);
+  to_words<T>(yy, y);
+  for (int j = 0; j < S + 2; j++)
+    a[j] = _mm256_setzero_si256();
+
+  for (int i = 0; i < S; i++)
+    {
+      // a += x_i * y
+      carry = _mm256_setzero_si256();
+      for (int j = 0; j < S; j++)
+        {
+          t = _mm256_add_epi64(_mm256_add_epi64(a[j], carry),
+              _mm256_mul_epu32(xx[i], yy[j]));
+          a[j] = _mm256_and_si256(t, mask);
+          carry = _mm256_srli_epi64(t, 32);
+        }
+      t = _mm256_add_epi64(a[S], carry);
+      a[S] = _mm256_and_si256(t, mask);
+      a[S + 1] = _mm256_srli_epi64(t, 32);
+
+      // a = (a + u * p) / 2^32
+      __m256i u = _mm256_mul_epu32(a[0], pi);
+      t = _mm256_add_epi64(a[0], _mm256_mul_epu32(u, p[0]));
+      carry = _mm256_srli_epi64(t, 32);
+      for (int j = 1; j < S; j++)
+        {
+          t = _mm256_add_epi64(_mm256_add_epi64(a[j], carry),
+              _mm256_mul_epu32(u, p[j]));
+          a[j - 1] = _mm256_and_si256(t, mask);
+          carry = _mm256_srli_epi64(t, 32);
+        }
+      t = _mm256_add_epi64(a[S], carry);
+      a[S - 1] = _mm256_and_si256(t, mask);
+      a[S] = _mm256_add_epi64(a[S + 1], _mm256_srli_epi64(t, 32));
+    }
+
+  // a - p unless negative
+  __m256i d[S], borrow = _mm256_setzero_si256();
+  for (int j = 0; j < S; j++)
+    {
+      t = _mm256_sub_epi64(_mm256_sub_epi64(a[j], p[j]), borrow);
+      d[j] = _mm256_and_si256(t, mask);
+      borrow = _mm256_srli_epi64(t, 63);
+    }
+  __m256d negative = _mm256_castsi256_pd(_mm256_sub_epi64(a[S], borrow));
+  for (int j = 0; j < T; j++)
+    {
+      __m256i r = _mm256_or_si256(a[2 * j],
+          _mm256_slli_epi64(a[2 * j + 1], 32));
+      __m256i s = _mm256_or_si256(d[2 * j],
+          _mm256_slli_epi64(d[2 * j + 1], 32));
+      z[j] = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(s),
+          _mm256_castsi256_pd(r), negative));
+    }
+}
+
+template<int T>
+size_t mont_mult_avx2(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+    size_t n, int z_step, int x_step, int y_step, const mp_limb_t* prA,
+    mp_limb_t pi)
+{
+  __m256i pr[T], p[2 * T];
+  for (int j = 0; j < T; j++)
+    pr[j] = _mm256_set1_epi64x(prA[j]);
+  to_words<T>(p, pr);
+  __m256i pi32 = _mm256_set1_epi64x(pi & 0xffffffff);
+
+  size_t i;
+  for (i = 0; i + AVX2_LANES <= n; i += AVX2_LANES)
+    {
+      __m256i xx[T], yy[T], zz[T];
+      avx2_load<T>(xx, x + i * x_step, x_step);
+      avx2_load<T>(yy, y + i * y_step, y_step);
+      mont_mult_avx2<T>(zz, xx, yy, p, pi32);
+      avx2_store<T>(z + i * z_step, z_step, zz);
+    }
+  return i;
+}
+
+}
+
+#endif
+
+void Zp_Data::Mont_Mult_batch(mp_limb_t* z, const mp_limb_t* x,
+    const mp_limb_t* y, size_t n, int z_step, int x_step, int y_step) const
+{
+  assert(montgomery);
+  size_t i = 0;
+#ifdef __AVX512IFMA__
+  if (cpu_has_avx512ifma())
+    {
+      if (t == 1)
+        i = mont_mult_ifma<1>(z, x, y, n, z_step, x_step, y_step, prA, pi);
+      else if (t == 2)
+        i = mont_mult_ifma<2>(z, x, y, n, z_step, x_step, y_step, prA, pi);
+    }
+  else
+#endif
+#ifdef __AVX2__
+  if (cpu_has_avx2())
+    {
+      if (t == 1)
+        i = mont_mult_avx2<1>(z, x, y, n, z_step, x_step, y_step, prA, pi);
+      else if (t == 2)
+        i = mont_mult_avx2<2>(z, x, y, n, z_step, x_step, y_step, prA, pi);
+    }
+#endif
+  for (; i < n; i++)
+    Mont_Mult(z + i * z_step, x + i * x_step, y + i * y_step);
+}
+
 
 
 ostream& operator<<(ostream& s,const Zp_Data& ZpD)
@@ -89,6 +89,11 @@ class Zp_Data
   void Sub(mp_limb_t* ans,const mp_limb_t* x,const mp_limb_t* y) const;
   void Sub(mp_limb_t* ans,const mp_limb_t* x,const mp_limb_t* y) const;
 
+  // Montgomery multiplication of n elements of t limbs each,
+  // element i at z + i * z_step etc. (steps in limbs, at least t)
+  void Mont_Mult_batch(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
+      size_t n, int z_step = 1, int x_step = 1, int y_step = 1) const;
+
   bool operator!=(const Zp_Data& other) const;
   bool operator==(const Zp_Data& other) const;
 
@@ -139,6 +139,13 @@ class gfp_ : public ValueInterface
 
   static gfp_ Mul(gfp_ a, gfp_ b) { return a * b; }
 
+  /**
+   * Elementwise multiplication of arrays, vectorized if possible
+   * @param z: result, element ``i`` at ``z[i * z_step]``
+   */
+  static void mul_batch(gfp_* z, const gfp_* x, const gfp_* y, size_t n,
+      int z_step = 1, int x_step = 1, int y_step = 1);
+
   static gfp_ power_of_two(bool bit, int exp);
 
   void assign_zero()        { assignZero(a,ZpD); }
@@ -66,6 +66,17 @@ void gfp_<X, L>::init_default(int lgp, bool mont)
   init_field(SPDZ_Data_Setup_Primes(lgp), mont);
 }
 
+template<int X, int L>
+void gfp_<X, L>::mul_batch(gfp_* z, const gfp_* x, const gfp_* y, size_t n,
+    int z_step, int x_step, int y_step)
+{
+  if (ZpD.get_mont())
+    ZpD.Mont_Mult_batch(z->a.x, x->a.x, y->a.x, n, z_step * L, x_step * L,
+        y_step * L);
+  else
+    ValueInterface::mul_batch(z, x, y, n, z_step, x_step, y_step);
+}
+
 template<int X, int L>
 gfp_<X, L>::gfp_(const gfpvar& other)
 {
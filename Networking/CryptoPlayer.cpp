@@ -141,10 +141,51 @@ void CryptoPlayer::receive_player_no_stats(int other, octetStream& o) const
     receivers[other]->wait(o);
 }
 
+void CryptoPlayer::send_parts_no_stats(int other,
+        const vector<const octetStream*>& parts) const
+{
+    assert(other != my_num());
+    // bypasses the sending thread
+    assert(not sending_async(other));
+    octetStream::Send(senders[other]->get_socket(), parts);
+}
+
+void CryptoPlayer::receive_raw_no_stats(int other, octet* buffer,
+        size_t length) const
+{
+    assert(other != my_num());
+    // bypasses the receiving thread
+    assert(not receiving_async(other));
+    octetStream::Receive(receivers[other]->get_socket(), buffer, length);
+}
+
+void CryptoPlayer::request_send_no_stats(int other, const octetStream& o) const
+{
+    assert(other != my_num());
+    senders[other]->request(o);
+}
+
+void CryptoPlayer::wait_send_no_stats(int other, const octetStream& o) const
+{
+    senders[other]->wait(o);
+}
+
+void CryptoPlayer::request_receive_no_stats(int other, octetStream& o) const
+{
+    assert(other != my_num());
+    receivers[other]->request(o);
+}
+
+void CryptoPlayer::wait_receive_no_stats(int other, octetStream& o) const
+{
+    receivers[other]->wait(o);
+}
+
 size_t CryptoPlayer::send_no_stats(int player, const PlayerBuffer& buffer,
         bool block) const
 {
     assert(player != my_num());
+    assert(not sending_async(player));
     auto socket = senders.at(player)->get_socket();
     if (block)
     {
@@ -159,6 +200,7 @@ size_t CryptoPlayer::recv_no_stats(int player, const PlayerBuffer& buffer,
         bool block) const
 {
     assert(player != my_num());
+    assert(not receiving_async(player));
     auto socket = receivers.at(player)->get_socket();
     if (block)
     {
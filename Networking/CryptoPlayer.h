@@ -46,6 +46,15 @@ public:
     void send_to_no_stats(int other, const octetStream& o) const;
     void receive_player_no_stats(int other, octetStream& o) const;
 
+    void send_parts_no_stats(int other,
+            const vector<const octetStream*>& parts) const;
+    void receive_raw_no_stats(int other, octet* buffer, size_t length) const;
+
+    void request_send_no_stats(int other, const octetStream& o) const;
+    void wait_send_no_stats(int other, const octetStream& o) const;
+    void request_receive_no_stats(int other, octetStream& o) const;
+    void wait_receive_no_stats(int other, octetStream& o) const;
+
     size_t send_no_stats(int player, const PlayerBuffer& buffer,
             bool block) const;
     size_t recv_no_stats(int player, const PlayerBuffer& buffer,
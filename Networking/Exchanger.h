@@ -14,16 +14,17 @@ template<class T>
 class Exchanger
 {
     T send_socket, receive_socket;
-    const octetStream& send_stream;
+    vector<const octetStream*> send_parts;
     octetStream& receive_stream;
+    bool same_buffer;
 
+    size_t part, part_sent;
     size_t sent, received;
     bool length_received;
     size_t new_len;
     size_t n_iter, n_send;
 
     size_t len;
-    octet* data;
 
     Timer recv_timer;
     Timer send_timer;
@@ -31,12 +32,29 @@ class Exchanger
 public:
     Exchanger(T send_socket, const octetStream& send_stream, T receive_socket,
             octetStream& receive_stream) :
-            send_socket(send_socket), receive_socket(receive_socket), send_stream(
-                    send_stream), receive_stream(receive_stream)
+            Exchanger(send_socket, vector<const octetStream*>({&send_stream}),
+                    receive_socket, receive_stream)
     {
-        len = send_stream.get_length();
-        data = send_stream.get_data();
+    }
+
+    // send several buffers as one message without concatenating them
+    Exchanger(T send_socket, const vector<const octetStream*>& send_parts,
+            T receive_socket, octetStream& receive_stream) :
+            send_socket(send_socket), receive_socket(receive_socket), send_parts(
+                    send_parts), receive_stream(receive_stream)
+    {
+        len = 0;
+        for (auto send_part : send_parts)
+            len += send_part->get_length();
+        same_buffer = send_parts.size() == 1
+                and send_parts[0] == &receive_stream;
+        if (not same_buffer)
+            for (auto send_part : send_parts)
+                if (send_part == &receive_stream)
+                    throw runtime_error("cannot receive into part of message");
         send(send_socket, len, LENGTH_SIZE);
+        part = 0;
+        part_sent = 0;
         sent = 0;
         received = 0;
         length_received = false;
@@ -66,15 +84,22 @@ public:
                 TimeScope ts(send_timer);
       #endif
             n_send++;
-            size_t to_send = len - sent;
+            while (part_sent == send_parts[part]->get_length())
+            {
+                part++;
+                part_sent = 0;
+            }
+            auto& send_part = *send_parts[part];
+            size_t to_send = send_part.get_length() - part_sent;
 #ifdef __APPLE__
             to_send = min(to_send, 1ul << 16);
 #endif
-            size_t newly_sent = send_non_blocking(send_socket, data + sent,
-                    to_send);
+            size_t newly_sent = send_non_blocking(send_socket,
+                    send_part.get_data() + part_sent, to_send);
 #ifdef TIME_ROUNDS
                 cout << "sent " << newly_sent << "/" << to_send << endl;
       #endif
+            part_sent += newly_sent;
             sent += newly_sent;
         }
 
@@ -85,7 +110,7 @@ public:
             // only receive up to already sent data
             // or when all is sent
             size_t to_receive = 0;
-            if (sent == len or &send_stream != &receive_stream)
+            if (sent == len or not same_buffer)
                 to_receive = new_len - received;
             else if (sent > received)
                 to_receive = sent - received;
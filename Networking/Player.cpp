@@ -4,6 +4,7 @@
 #include "Tools/Exceptions.h"
 #include "Tools/int.h"
 #include "Tools/NetworkOptions.h"
+#include "Tools/Trace.h"
 #include "Networking/Server.h"
 #include "Networking/ServerSocket.h"
 #include "Networking/Exchanger.h"
@@ -271,6 +272,10 @@ PlainPlayer::~PlainPlayer()
 template<class T>
 MultiPlayer<T>::~MultiPlayer()
 {
+  for (auto sender : async_senders)
+    delete sender;
+  for (auto receiver : async_receivers)
+    delete receiver;
 }
 
 Player::~Player()
@@ -279,6 +284,8 @@ Player::~Player()
   for (auto& x : thread_stats)
     x.print();
 #endif
+  for (auto buffer : send_buffers)
+    delete buffer;
 }
 
 PlayerBase::~PlayerBase()
@@ -374,6 +381,7 @@ void Player::send_to(int player,const octetStream& o) const
   cerr << "sending to " << player << endl;
 #endif
   TimeScope ts(comm_stats["Sending directly"].add(o));
+  TraceScope trace("send", "network", player, o.get_length());
   send_to_no_stats(player, o);
   sent += o.get_length();
 }
@@ -381,6 +389,7 @@ void Player::send_to(int player,const octetStream& o) const
 template<class T>
 void MultiPlayer<T>::send_to_no_stats(int player,const octetStream& o) const
 {
+  assert(not sending_async(player));
   T socket = socket_to_send(player);
   o.Send(socket);
 }
@@ -389,6 +398,7 @@ void MultiPlayer<T>::send_to_no_stats(int player,const octetStream& o) const
 void Player::send_all(const octetStream& o) const
 {
   TimeScope ts(comm_stats["Sending to all"].add(o));
+  TraceScope trace("send to all", "network", -1, o.get_length());
   for (int i=0; i<nplayers; i++)
      { if (i!=player_no)
          send_to_no_stats(i, o);
@@ -412,17 +422,209 @@ void Player::receive_player(int i,octetStream& o) const
   cerr << "receiving from " << i << endl;
 #endif
   TimeScope ts(timer);
+  TraceScope trace("receive", "network", i);
   receive_player_no_stats(i, o);
+  trace.set_bytes(o.get_length());
   comm_stats["Receiving directly"].add(o, ts);
 }
 
 template<class T>
 void MultiPlayer<T>::receive_player_no_stats(int i,octetStream& o) const
 {
+  assert(not receiving_async(i));
   o.reset_write_head();
   o.Receive(sockets[i]);
 }
 
+void Player::send_to(int player, const vector<const octetStream*>& parts) const
+{
+  size_t length = 0;
+  for (auto part : parts)
+    length += part->get_length();
+  TimeScope ts(comm_stats["Sending directly"].add(length));
+  TraceScope trace("send", "network", player, length);
+  send_parts_no_stats(player, parts);
+  sent += length;
+}
+
+void Player::send_parts_no_stats(int player,
+    const vector<const octetStream*>& parts) const
+{
+  octetStream os;
+  for (auto part : parts)
+    os.concat(*part);
+  send_to_no_stats(player, os);
+}
+
+template<class T>
+void MultiPlayer<T>::send_parts_no_stats(int player,
+    const vector<const octetStream*>& parts) const
+{
+  assert(not sending_async(player));
+  octetStream::Send(socket_to_send(player), parts);
+}
+
+void Player::receive_raw_no_stats(int i, octet* buffer, size_t length) const
+{
+  octetStream os;
+  receive_player_no_stats(i, os);
+  if (os.get_length() != length)
+    throw runtime_error("unexpected message length");
+  memcpy(buffer, os.get_data(), length);
+}
+
+template<class T>
+void MultiPlayer<T>::receive_raw_no_stats(int i, octet* buffer,
+    size_t length) const
+{
+  assert(not receiving_async(i));
+  octetStream::Receive(sockets[i], buffer, length);
+}
+
+CommRequest Player::isend(int player, octetStream& o) const
+{
+#ifdef VERBOSE_COMM
+  cerr << "starting to send to " << player << endl;
+#endif
+  TimeScope ts(comm_stats["Sending asynchronously"].add(o));
+  octetStream* buffer;
+  if (send_buffers.empty())
+    buffer = new octetStream;
+  else
+    {
+      buffer = send_buffers.back();
+      send_buffers.pop_back();
+    }
+  buffer->swap(o);
+  o.reset_write_head();
+  request_send_no_stats(player, *buffer);
+  sent += buffer->get_length();
+  pending_sends.resize(num_players());
+  pending_sends[player]++;
+  return {this, player, buffer, true};
+}
+
+CommRequest Player::irecv(int player, octetStream& o) const
+{
+#ifdef VERBOSE_COMM
+  cerr << "starting to receive from " << player << endl;
+#endif
+  request_receive_no_stats(player, o);
+  pending_receives.resize(num_players());
+  pending_receives[player]++;
+  return {this, player, &o, false};
+}
+
+void Player::finish(CommRequest& request) const
+{
+  if (request.sending)
+    {
+      wait_send_no_stats(request.player, *request.os);
+      send_buffers.push_back(request.os);
+      pending_sends.at(request.player)--;
+    }
+  else
+    {
+      TimeScope ts(timer);
+      TraceScope trace("wait for receive", "network", request.player);
+      wait_receive_no_stats(request.player, *request.os);
+      trace.set_bytes(request.os->get_length());
+      comm_stats["Receiving asynchronously"].add(*request.os, ts);
+      pending_receives.at(request.player)--;
+    }
+}
+
+bool Player::sending_async(int player) const
+{
+  return size_t(player) < pending_sends.size() and pending_sends[player];
+}
+
+bool Player::receiving_async(int player) const
+{
+  return size_t(player) < pending_receives.size()
+      and pending_receives[player];
+}
+
+CommRequest::CommRequest(CommRequest&& other) :
+    CommRequest()
+{
+  *this = std::move(other);
+}
+
+CommRequest::~CommRequest()
+{
+  if (P)
+    wait();
+}
+
+CommRequest& CommRequest::operator=(CommRequest&& other)
+{
+  if (P)
+    wait();
+  P = other.P;
+  player = other.player;
+  os = other.os;
+  sending = other.sending;
+  other.P = 0;
+  return *this;
+}
+
+void CommRequest::wait()
+{
+  if (not P)
+    return;
+  auto P = this->P;
+  this->P = 0;
+  P->finish(*this);
+}
+
+template<class T>
+Sender<T>& MultiPlayer<T>::get_async_sender(int player) const
+{
+  assert(player != my_num());
+  async_senders.resize(num_players());
+  auto& sender = async_senders[player];
+  if (not sender)
+    sender = new Sender<T>(socket_to_send(player), player);
+  return *sender;
+}
+
+template<class T>
+Receiver<T>& MultiPlayer<T>::get_async_receiver(int player) const
+{
+  assert(player != my_num());
+  async_receivers.resize(num_players());
+  auto& receiver = async_receivers[player];
+  if (not receiver)
+    receiver = new Receiver<T>(sockets[player], player);
+  return *receiver;
+}
+
+template<class T>
+void MultiPlayer<T>::request_send_no_stats(int player,
+    const octetStream& o) const
+{
+  get_async_sender(player).request(o);
+}
+
+template<class T>
+void MultiPlayer<T>::wait_send_no_stats(int player, const octetStream& o) const
+{
+  get_async_sender(player).wait(o);
+}
+
+template<class T>
+void MultiPlayer<T>::request_receive_no_stats(int player, octetStream& o) const
+{
+  get_async_receiver(player).request(o);
+}
+
+template<class T>
+void MultiPlayer<T>::wait_receive_no_stats(int player, octetStream& o) const
+{
+  get_async_receiver(player).wait(o);
+}
+
 void Player::receive_player(int i, FlexBuffer& buffer) const
 {
   octetStream os;
@@ -433,6 +635,7 @@ void Player::receive_player(int i, FlexBuffer& buffer) const
 size_t PlainPlayer::send_no_stats(int player,
         const PlayerBuffer& buffer, bool block) const
 {
+  assert(not sending_async(player));
   if (block)
     {
       send(socket(player), buffer.data, buffer.size);
@@ -445,6 +648,7 @@ size_t PlainPlayer::send_no_stats(int player,
 size_t PlainPlayer::recv_no_stats(int player,
         const PlayerBuffer& buffer, bool block) const
 {
+    assert(not receiving_async(player));
     if (block)
       {
         receive(socket(player), buffer.data, buffer.size);
@@ -482,6 +686,7 @@ void Player::receive_relative(int offset, octetStream& o) const
 template<class T>
 void MultiPlayer<T>::exchange_no_stats(int other, const octetStream& o, octetStream& to_receive) const
 {
+  assert(not sending_async(other) and not receiving_async(other));
   o.exchange(sockets[other], sockets[other], to_receive);
 }
 
@@ -491,6 +696,7 @@ void Player::exchange(int other, const octetStream& o, octetStream& to_receive)
   cerr << "Exchanging with " << other << endl;
 #endif
   TimeScope ts(comm_stats["Exchanging"].add(o));
+  TraceScope trace("exchange", "network", other, o.get_length());
   exchange_no_stats(other, o, to_receive);
   sent += o.get_length();
 }
@@ -510,12 +716,16 @@ void Player::exchange_relative(int offset, octetStream& o) const
 template<class T>
 void MultiPlayer<T>::pass_around_no_stats(const octetStream& o, octetStream& to_receive, int offset) const
 {
+  assert(not sending_async(get_player(offset)));
+  assert(not receiving_async(get_player(-offset)));
   o.exchange(sockets.at(get_player(offset)), sockets.at(get_player(-offset)), to_receive);
 }
 
 void Player::pass_around(octetStream& o, octetStream& to_receive, int offset) const
 {
   TimeScope ts(comm_stats["Passing around"].add(o));
+  TraceScope trace("pass around", "network", get_player(offset),
+      o.get_length());
   pass_around_no_stats(o, to_receive, offset);
   sent += o.get_length();
 }
@@ -526,16 +736,28 @@ void Player::pass_around(octetStream& o, octetStream& to_receive, int offset) co
  */
 template<class T>
 void MultiPlayer<T>::Broadcast_Receive_no_stats(vector<octetStream>& o) const
+{
+  if (o.size() != sockets.size())
+    throw runtime_error("player numbers don't match");
+
+  broadcast_parts_no_stats({&o[my_num()]}, o);
+}
+
+template<class T>
+void MultiPlayer<T>::broadcast_parts_no_stats(
+    const vector<const octetStream*>& parts, vector<octetStream>& o) const
 {
   if (o.size() != sockets.size())
     throw runtime_error("player numbers don't match");
 
   vector<Exchanger<T>> exchangers;
+  exchangers.reserve(nplayers - 1);
   for (int i=1; i<nplayers; i++)
     {
       int send_to = (my_num() + i) % num_players();
       int receive_from = (my_num() + num_players() - i) % num_players();
-      exchangers.push_back({sockets[send_to], o[my_num()], sockets[receive_from], o[receive_from]});
+      exchangers.emplace_back(sockets[send_to], parts, sockets[receive_from],
+          o[receive_from]);
     }
 
   int left = 1;
@@ -550,10 +772,34 @@ void MultiPlayer<T>::Broadcast_Receive_no_stats(vector<octetStream>& o) const
 void Player::unchecked_broadcast(vector<octetStream>& o) const
 {
   TimeScope ts(comm_stats["Broadcasting"].add(o[player_no]));
+  TraceScope trace("broadcast", "network", -1, o[player_no].get_length());
   Broadcast_Receive_no_stats(o);
   sent += o[player_no].get_length() * (num_players() - 1);
 }
 
+void Player::unchecked_broadcast(const vector<const octetStream*>& parts,
+    vector<octetStream>& o) const
+{
+  size_t length = 0;
+  for (auto part : parts)
+    length += part->get_length();
+  TimeScope ts(comm_stats["Broadcasting"].add(length));
+  TraceScope trace("broadcast", "network", -1, length);
+  broadcast_parts_no_stats(parts, o);
+  sent += length * (num_players() - 1);
+}
+
+void Player::broadcast_parts_no_stats(const vector<const octetStream*>& parts,
+    vector<octetStream>& o) const
+{
+  octetStream mine;
+  for (auto part : parts)
+    mine.concat(*part);
+  swap(mine, o.at(my_num()));
+  Broadcast_Receive_no_stats(o);
+  swap(mine, o.at(my_num()));
+}
+
 void Player::Broadcast_Receive(vector<octetStream>& o) const
 {
   unchecked_broadcast(o);
@@ -568,12 +814,12 @@ void Player::Check_Broadcast() const
   if (ctx.size == 0)
     return;
   vector<octetStream> h(nplayers);
-  h[player_no].concat(ctx.final());
+  octetStream mine = ctx.final();
 
-  unchecked_broadcast(h);
+  unchecked_broadcast({&mine}, h);
   for (int i=0; i<nplayers; i++)
     { if (i!=player_no)
-        { if (!h[i].equals(h[player_no]))
+        { if (!h[i].equals(mine))
 	    { throw broadcast_invalid(); }
         }
     }
@@ -611,10 +857,40 @@ void Player::send_receive_all(const vector<vector<bool>>& channels,
 #endif
       }
   TimeScope ts(comm_stats["Sending/receiving"].add(data));
+  TraceScope trace("send/receive", "network", -1, data);
   sent += data;
   send_receive_all_no_stats(channels, to_send, to_receive);
 }
 
+void Player::send_receive_all(
+    const vector<vector<const octetStream*>>& to_send,
+    vector<octetStream>& to_receive) const
+{
+  size_t data = 0;
+  for (int i = 0; i < num_players(); i++)
+    if (i != my_num())
+      for (auto part : to_send.at(i))
+        data += part->get_length();
+  TimeScope ts(comm_stats["Sending/receiving"].add(data));
+  TraceScope trace("send/receive", "network", -1, data);
+  sent += data;
+  send_receive_parts_no_stats(
+      vector<vector<bool>>(num_players(), vector<bool>(num_players(), true)),
+      to_send, to_receive);
+}
+
+void Player::send_receive_parts_no_stats(const vector<vector<bool>>& channels,
+    const vector<vector<const octetStream*>>& to_send,
+    vector<octetStream>& to_receive) const
+{
+  vector<octetStream> concatenated(num_players());
+  for (int i = 0; i < num_players(); i++)
+    if (i != my_num())
+      for (auto part : to_send.at(i))
+        concatenated[i].concat(*part);
+  send_receive_all_no_stats(channels, concatenated, to_receive);
+}
+
 void Player::partial_broadcast(const vector<bool>&,
     const vector<bool>&, vector<octetStream>& os) const
 {
@@ -625,6 +901,19 @@ template<class T>
 void MultiPlayer<T>::send_receive_all_no_stats(
     const vector<vector<bool>>& channels, const vector<octetStream>& to_send,
     vector<octetStream>& to_receive) const
+{
+  vector<vector<const octetStream*>> parts;
+  parts.reserve(to_send.size());
+  for (auto& os : to_send)
+    parts.push_back({&os});
+  send_receive_parts_no_stats(channels, parts, to_receive);
+}
+
+template<class T>
+void MultiPlayer<T>::send_receive_parts_no_stats(
+    const vector<vector<bool>>& channels,
+    const vector<vector<const octetStream*>>& to_send,
+    vector<octetStream>& to_receive) const
 {
   to_receive.resize(num_players());
   for (int offset = 1; offset < num_players(); offset++)
@@ -635,9 +924,14 @@ void MultiPlayer<T>::send_receive_all_no_stats(
       if (channels[my_num()][send_to])
         {
           if (receive)
-            pass_around_no_stats(to_send[send_to], to_receive[receive_from], offset);
+            {
+              Exchanger<T> exchanger(sockets.at(send_to), to_send[send_to],
+                  sockets.at(receive_from), to_receive[receive_from]);
+              while (exchanger.round())
+                ;
+            }
           else
-            send_to_no_stats(send_to, to_send[send_to]);
+            send_parts_no_stats(send_to, to_send[send_to]);
         }
       else if (receive)
         receive_player_no_stats(receive_from, to_receive[receive_from]);
@@ -688,6 +982,26 @@ void ThreadPlayer::receive_player_no_stats(int i, octetStream& o) const
   wait_receive(i, o);
 }
 
+void ThreadPlayer::request_send_no_stats(int i, const octetStream& o) const
+{
+  senders[i]->request(o);
+}
+
+void ThreadPlayer::wait_send_no_stats(int i, const octetStream& o) const
+{
+  senders[i]->wait(o);
+}
+
+void ThreadPlayer::request_receive_no_stats(int i, octetStream& o) const
+{
+  receivers[i]->request(o);
+}
+
+void ThreadPlayer::wait_receive_no_stats(int i, octetStream& o) const
+{
+  receivers[i]->wait(o);
+}
+
 void ThreadPlayer::send_all(const octetStream& o) const
 {
   for (int i=0; i<nplayers; i++)
@@ -719,6 +1033,7 @@ RealTwoPartyPlayer::~RealTwoPartyPlayer()
 void VirtualTwoPartyPlayer::send(octetStream& o) const
 {
   TimeScope ts(comm_stats["Sending one-to-one"].add(o));
+  TraceScope trace("send", "network", other_player, o.get_length());
   P.send_to_no_stats(other_player, o);
   comm_stats.sent += o.get_length();
 }
@@ -726,13 +1041,16 @@ void VirtualTwoPartyPlayer::send(octetStream& o) const
 void VirtualTwoPartyPlayer::receive(octetStream& o) const
 {
   TimeScope ts(timer);
+  TraceScope trace("receive", "network", other_player);
   P.receive_player_no_stats(other_player, o);
+  trace.set_bytes(o.get_length());
   comm_stats["Receiving one-to-one"].add(o, ts);
 }
 
 void VirtualTwoPartyPlayer::send_receive_player(vector<octetStream>& o) const
 {
   TimeScope ts(comm_stats["Exchanging one-to-one"].add(o[0]));
+  TraceScope trace("exchange", "network", other_player, o[0].get_length());
   comm_stats.sent += o[0].get_length();
   P.exchange_no_stats(other_player, o[0], o[1]);
 }
@@ -909,5 +1227,24 @@ NamedCommStats Player::total_comm() const
   return res;
 }
 
+size_t Player::total_sent() const
+{
+  size_t res = comm_stats.sent;
+  for (auto& x : thread_stats)
+    res += x.sent;
+  return res;
+}
+
+size_t Player::total_rounds() const
+{
+  size_t res = 0;
+  for (auto& x : comm_stats)
+    res += x.second.rounds;
+  for (auto& x : thread_stats)
+    for (auto& y : x)
+      res += y.second.rounds;
+  return res;
+}
+
 template class MultiPlayer<int>;
 template class MultiPlayer<ssl_socket*> ;
@@ -223,6 +223,41 @@ public:
   { throw not_implemented(); }
 };
 
+class Player;
+
+/**
+ * Handle for non-blocking communication started by
+ * :cpp:func:`Player::isend` or :cpp:func:`Player::irecv`.
+ * The destructor waits if this has not been done before.
+ */
+class CommRequest
+{
+  friend class Player;
+
+  const Player* P;
+  int player;
+  octetStream* os;
+  bool sending;
+
+  CommRequest(const Player* P, int player, octetStream* os, bool sending) :
+      P(P), player(player), os(os), sending(sending) {}
+
+public:
+  CommRequest() : P(0), player(-1), os(0), sending(false) {}
+  CommRequest(const CommRequest&) = delete;
+  CommRequest(CommRequest&& other);
+  ~CommRequest();
+
+  CommRequest& operator=(CommRequest&& other);
+
+  /**
+   * Block until the data is sent or received
+   */
+  void wait();
+
+  bool pending() const { return P; }
+};
+
 /**
  * Abstract class for multi-player communication.
  * ``*_no_stats`` functions are called by their equivalents
@@ -235,6 +270,19 @@ protected:
 
   mutable Hash ctx;
 
+  // recycled buffers for isend()
+  mutable vector<octetStream*> send_buffers;
+
+  // isend() and irecv() requests not waited for by player
+  mutable vector<int> pending_sends, pending_receives;
+
+  friend class CommRequest;
+  void finish(CommRequest& request) const;
+
+  // direct socket access would overtake the communication threads
+  bool sending_async(int player) const;
+  bool receiving_async(int player) const;
+
 public:
   const Names& N;
 
@@ -286,11 +334,50 @@ public:
   virtual void receive_player_no_stats(int i,octetStream& o) const = 0;
   virtual void receive_player(int i,FlexBuffer& buffer) const;
 
+  /**
+   * Send several buffers to a specific player as one message
+   * without concatenating them
+   */
+  void send_to(int player, const vector<const octetStream*>& parts) const;
+  virtual void send_parts_no_stats(int player,
+      const vector<const octetStream*>& parts) const;
+  /**
+   * Receive from a specific player directly into ``values``,
+   * which must have the right size.
+   * Expects the format of ``octetStream::store_no_resize()``.
+   */
+  template<class U>
+  void receive_player(int i, vector<U>& values) const;
+  virtual void receive_raw_no_stats(int i, octet* buffer, size_t length) const;
+
   virtual size_t send_no_stats(int, const PlayerBuffer&, bool) const
   { throw not_implemented(); }
   virtual size_t recv_no_stats(int, const PlayerBuffer&, bool) const
   { throw not_implemented(); }
 
+  /**
+   * Start sending to a specific player without blocking.
+   * The content of ``o`` is moved to a buffer from a pool,
+   * and ``o`` holds an empty recycled buffer afterwards,
+   * so it can be filled with the next batch straight away.
+   * Requests to the same player have to be waited for in order,
+   * and they have to be done before any other communication
+   * with that player.
+   */
+  CommRequest isend(int player, octetStream& o) const;
+  /**
+   * Start receiving from a specific player without blocking.
+   * ``o`` must not be accessed before waiting for the request.
+   */
+  CommRequest irecv(int player, octetStream& o) const;
+  // blocking by default
+  virtual void request_send_no_stats(int player, const octetStream& o) const
+  { send_to_no_stats(player, o); }
+  virtual void wait_send_no_stats(int, const octetStream&) const {}
+  virtual void request_receive_no_stats(int, octetStream&) const {}
+  virtual void wait_receive_no_stats(int player, octetStream& o) const
+  { receive_player_no_stats(player, o); }
+
   /**
    * Send to all other players by offset.
    * ``o[0]`` gets sent to the next player etc.
@@ -354,6 +441,15 @@ public:
   virtual void Broadcast_Receive(vector<octetStream>& o) const;
   virtual void Broadcast_Receive_no_stats(vector<octetStream>&) const
   { throw runtime_error("implement broadcast"); }
+  /**
+   * Broadcast several buffers as one message without concatenating them
+   * and receive from all other players.
+   * ``o[player_no]`` is left unchanged.
+   */
+  void unchecked_broadcast(const vector<const octetStream*>& parts,
+      vector<octetStream>& o) const;
+  virtual void broadcast_parts_no_stats(const vector<const octetStream*>& parts,
+      vector<octetStream>& o) const;
 
   /**
    * Run protocol to verify broadcast is correct
@@ -387,6 +483,17 @@ public:
   virtual void send_receive_all_no_stats(const vector<vector<bool>>& channels,
       const vector<octetStream>& to_send,
       vector<octetStream>& to_receive) const = 0;
+  /**
+   * Send something different to each player,
+   * given as several buffers that are not concatenated.
+   * @param to_send message parts by player number
+   * @param to_receive received data by player number
+   */
+  void send_receive_all(const vector<vector<const octetStream*>>& to_send,
+      vector<octetStream>& to_receive) const;
+  virtual void send_receive_parts_no_stats(const vector<vector<bool>>& channels,
+      const vector<vector<const octetStream*>>& to_send,
+      vector<octetStream>& to_receive) const;
 
   /**
    * Specified senders broadcast information to specified receivers.
@@ -404,6 +511,9 @@ public:
   { receive_player(i, o); }
 
   NamedCommStats total_comm() const;
+  // cheaper than total_comm() for frequent use
+  size_t total_sent() const;
+  size_t total_rounds() const;
   void reset_stats();
 };
 
@@ -424,6 +534,13 @@ protected:
   T socket_to_send(int player) const { return player == player_no ? send_to_self_socket : sockets[player]; }
   T socket(int i) const { return sockets[i]; }
 
+  // communication threads for isend() and irecv(), started on demand
+  mutable vector<Sender<T>*> async_senders;
+  mutable vector<Receiver<T>*> async_receivers;
+
+  Sender<T>& get_async_sender(int player) const;
+  Receiver<T>& get_async_receiver(int player) const;
+
   friend class CryptoPlayer;
 
 public:
@@ -458,6 +575,21 @@ public:
   virtual void send_receive_all_no_stats(const vector<vector<bool>>& channels,
       const vector<octetStream>& to_send,
       vector<octetStream>& to_receive) const;
+
+  void broadcast_parts_no_stats(const vector<const octetStream*>& parts,
+      vector<octetStream>& o) const;
+  void send_receive_parts_no_stats(const vector<vector<bool>>& channels,
+      const vector<vector<const octetStream*>>& to_send,
+      vector<octetStream>& to_receive) const;
+
+  void send_parts_no_stats(int player,
+      const vector<const octetStream*>& parts) const;
+  void receive_raw_no_stats(int i, octet* buffer, size_t length) const;
+
+  void request_send_no_stats(int player, const octetStream& o) const;
+  void wait_send_no_stats(int player, const octetStream& o) const;
+  void request_receive_no_stats(int player, octetStream& o) const;
+  void wait_receive_no_stats(int player, octetStream& o) const;
 };
 
 /**
@@ -484,6 +616,27 @@ public:
 };
 
 
+template<class U>
+void Player::receive_player(int i, vector<U>& values) const
+{
+  TimeScope ts(timer);
+  size_t length = values.size() * U::size();
+  // raw copy only if the memory layout matches
+  if (sizeof(U) == size_t(U::size()))
+    receive_raw_no_stats(i, (octet*) values.data(), length);
+  else
+    {
+      octetStream os;
+      receive_player_no_stats(i, os);
+      if (os.get_length() != length)
+        throw runtime_error("unexpected message length");
+      for (auto& x : values)
+        os.get_no_check(x);
+    }
+  comm_stats["Receiving directly"].add(length) += ts;
+}
+
+
 class ThreadPlayer : public PlainPlayer
 {
 public:
@@ -497,6 +650,11 @@ public:
   void wait_receive(int i, octetStream& o) const;
   void receive_player_no_stats(int i,octetStream& o) const;
 
+  void request_send_no_stats(int i, const octetStream& o) const;
+  void wait_send_no_stats(int i, const octetStream& o) const;
+  void request_receive_no_stats(int i, octetStream& o) const;
+  void wait_receive_no_stats(int i, octetStream& o) const;
+
   void send_all(const octetStream& o) const;
 };
 
@@ -18,7 +18,9 @@
 
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/wait.h>   /* Wait for Process Termination */
+#include <limits.h>
 
 #include <iostream>
 using namespace std;
@@ -76,6 +78,38 @@ inline void send(int socket,octet *msg,size_t len)
     }
 }
 
+// gather several buffers in as few system calls as possible,
+// modifies iov to keep track of partial writes
+inline void send(int socket, iovec* iov, int iovcnt)
+{
+  long wait = 1;
+  while (iovcnt > 0)
+    {
+      ssize_t j = writev(socket, iov, min(iovcnt, IOV_MAX));
+      if (j < 0)
+        {
+          if (errno != EINTR and errno != EAGAIN and errno != EWOULDBLOCK and
+              errno != ENOBUFS)
+            error("Sending error", true);
+          usleep(wait);
+          wait *= 2;
+          continue;
+        }
+      wait = 1;
+      while (iovcnt > 0 and size_t(j) >= iov->iov_len)
+        {
+          j -= iov->iov_len;
+          iov++;
+          iovcnt--;
+        }
+      if (iovcnt > 0)
+        {
+          iov->iov_base = (octet*) iov->iov_base + j;
+          iov->iov_len -= j;
+        }
+    }
+}
+
 template<class T>
 inline void send(T& socket, size_t a, size_t len)
 {
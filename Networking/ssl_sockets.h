@@ -102,6 +102,13 @@ inline void send(ssl_socket* socket, octet* data, size_t length)
     }
 }
 
+// the buffers are encrypted separately anyway
+inline void send(ssl_socket* socket, iovec* iov, int iovcnt)
+{
+    for (int i = 0; i < iovcnt; i++)
+        send(socket, (octet*) iov[i].iov_base, iov[i].iov_len);
+}
+
 inline void receive(ssl_socket* socket, octet* data, size_t length)
 {
     size_t received = 0;
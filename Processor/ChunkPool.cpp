@@ -0,0 +1,83 @@
+/*
+ * ChunkPool.cpp
+ *
+ */
+
+#include "ChunkPool.h"
+#include "Networking/Player.h"
+#include "Tools/Exceptions.h"
+
+ChunkPool::ChunkPool() :
+        n_chunks(0), n_threads(0), next(0), n_done(0)
+{
+}
+
+void ChunkPool::reset(int n_chunks, int n_threads)
+{
+    if (n_chunks < 0 or n_threads <= 0)
+        throw Processor_Error("invalid work distribution");
+
+    ScopeLock _(lock);
+    this->n_chunks = n_chunks;
+    this->n_threads = n_threads;
+    next = 0;
+    n_done = 0;
+    assigned.clear();
+    assigned.resize(n_chunks);
+}
+
+int ChunkPool::next_chunk(Player& P)
+{
+    int chunk;
+    if (P.my_num() == 0)
+    {
+        chunk = claim();
+        if (P.num_players() > 1)
+        {
+            octetStream os;
+            os.store(chunk);
+            P.send_all(os);
+        }
+    }
+    else
+    {
+        octetStream os;
+        P.receive_player(0, os);
+        os.get(chunk);
+    }
+
+    if (chunk < 0)
+        finish();
+    else
+        record(chunk);
+
+    return chunk;
+}
+
+int ChunkPool::claim()
+{
+    ScopeLock _(lock);
+    if (next < n_chunks)
+        return next++;
+    else
+        return -1;
+}
+
+void ChunkPool::record(int chunk)
+{
+    ScopeLock _(lock);
+    if (chunk >= n_chunks or assigned[chunk])
+        throw Processor_Error("inconsistent work distribution");
+    assigned[chunk] = true;
+}
+
+void ChunkPool::finish()
+{
+    ScopeLock _(lock);
+    // every thread receives its chunks in order, so all chunks
+    // must be assigned once the last thread is done
+    if (++n_done == n_threads)
+        for (bool x : assigned)
+            if (not x)
+                throw Processor_Error("incomplete work distribution");
+}
@@ -0,0 +1,45 @@
+/*
+ * ChunkPool.h
+ *
+ */
+
+#ifndef PROCESSOR_CHUNKPOOL_H_
+#define PROCESSOR_CHUNKPOOL_H_
+
+#include "Tools/Lock.h"
+
+#include <vector>
+using namespace std;
+
+class Player;
+
+/**
+ * Chunks of a multithreaded loop handed out to whichever thread asks first.
+ * Player 0 decides the order and tells the others through the channel
+ * of the asking thread, so the same thread processes the same chunk
+ * everywhere. The others check that every chunk is assigned exactly once.
+ */
+class ChunkPool
+{
+    Lock lock;
+    int n_chunks;
+    int n_threads;
+    int next;
+    int n_done;
+    vector<bool> assigned;
+
+    int claim();
+    void record(int chunk);
+    void finish();
+
+public:
+    ChunkPool();
+
+    // start handing out chunks to given number of threads
+    void reset(int n_chunks, int n_threads);
+
+    // next chunk for calling thread or -1 if all chunks are assigned
+    int next_chunk(Player& P);
+};
+
+#endif /* PROCESSOR_CHUNKPOOL_H_ */
@@ -29,6 +29,9 @@ public:
 
     Conv2dTuple(const vector<int>& args, int start);
 
+    // reuse for another set of arguments, keeping the memory of lengths
+    void reset(const vector<int>& args, int start);
+
     array<int, 3> matrix_dimensions();
 
     template<class T>
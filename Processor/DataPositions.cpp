@@ -200,6 +200,31 @@ bool DataPositions::empty() const
   return true;
 }
 
+long long DataPositions::total() const
+{
+  long long res = 0;
+
+  for (auto& x : files)
+    for (auto& y : x)
+      res += y;
+
+  for (auto& x : inputs)
+    for (auto& y : x)
+      res += y;
+
+  for (auto& x : extended)
+    for (auto& y : x)
+      res += y.second;
+
+  for (auto& x : edabits)
+    res += x.second;
+
+  for (auto& x : matmuls)
+    res += x.second;
+
+  return res;
+}
+
 bool DataPositions::any_more(const DataPositions& other) const
 {
   for (unsigned int field_type = 0; field_type < N_DATA_FIELD_TYPE;
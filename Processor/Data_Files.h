@@ -87,6 +87,8 @@ public:
   void print_cost() const;
   bool empty() const;
   bool any_more(const DataPositions& other) const;
+  // number of items of all kinds
+  long long total() const;
 
   long long total_edabits(int n_bits) const;
 
@@ -365,8 +367,7 @@ bool Sub_Data_Files<T>::input_eof(int player)
 template<class T>
 inline void Sub_Data_Files<T>::get_no_count(Dtype dtype, T* a)
 {
-  for (int i = 0; i < DataPositions::tuple_size[dtype]; i++)
-    buffers[dtype].input(a[i]);
+  buffers[dtype].input(a, DataPositions::tuple_size[dtype]);
 }
 
 template<class T>
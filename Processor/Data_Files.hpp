@@ -35,7 +35,8 @@ Preprocessing<T>* Preprocessing<T>::get_new(
     bool live_prep, const Names& N,
     DataPositions& usage)
 {
-  if (live_prep)
+  // there are no files for disabled domains
+  if (live_prep or not T::is_real)
     return new typename T::LivePrep(usage);
   else
     return new GC::BitPrepFiles<T>(N,
@@ -358,9 +359,14 @@ template<class T>
 void Sub_Data_Files<T>::get_no_count(StackedVector<T>& S, DataTag tag, const vector<int>& regs, int vector_size)
 {
   setup_extended(tag, regs.size());
-  for (int j = 0; j < vector_size; j++)
-    for (unsigned int i = 0; i < regs.size(); i++)
-      extended[tag].input(S[regs[i] + j]);
+  // single vector can be read in one go
+  if (regs.size() == 1)
+    extended[tag].input(&*S.iterator_for_size(regs[0], vector_size),
+        vector_size);
+  else
+    for (int j = 0; j < vector_size; j++)
+      for (unsigned int i = 0; i < regs.size(); i++)
+        extended[tag].input(S[regs[i] + j]);
 }
 
 template<class T>
@@ -61,6 +61,7 @@ void Instruction::execute_regint(ArithmeticProcessor& Proc, MemoryPart<Integer>&
 {
     (void) Mi;
     auto& Ci = Proc.get_Ci();
+    auto& instruction = *this;
     switch (opcode)
     {
 #define X(NAME, PRE, CODE) \
@@ -104,6 +105,7 @@ string BaseInstruction::get_name() const
 #define X(NAME, CODE) \
     case NAME: return #NAME;
     COMBI_INSTRUCTIONS
+#undef X
     default:
         stringstream ss;
         ss << showbase << hex << get_opcode();
@@ -111,6 +113,35 @@ string BaseInstruction::get_name() const
     }
 }
 
+int BaseInstruction::get_dispatch_handler() const
+{
+    switch (get_opcode())
+    {
+#define X(NAME, PRE, CODE) \
+    case NAME: return DISPATCH_##NAME;
+    ARITHMETIC_INSTRUCTIONS
+    REGINT_INSTRUCTIONS
+    FUSED_INSTRUCTIONS
+#undef X
+#define X(NAME, PRE, CODE) case NAME:
+    CLEAR_GF2N_INSTRUCTIONS
+#undef X
+        return DISPATCH_CLEAR_GF2N;
+#define X(NAME, CODE) case NAME:
+    COMBI_INSTRUCTIONS
+#undef X
+        return DISPATCH_COMBI;
+    case JMP:
+        return DISPATCH_JMP;
+    case JMPNZ:
+        return DISPATCH_JMPNZ;
+    case JMPEQZ:
+        return DISPATCH_JMPEQZ;
+    default:
+        return DISPATCH_OTHER;
+    }
+}
+
 void BaseInstruction::bytecode_assert(bool condition) const
 {
     if (not condition)
@@ -76,6 +76,8 @@ enum
     CMDLINEARG = 0xEB,
     CALL_TAPE = 0xEC,
     CALL_ARG = 0xED,
+    INITCHUNKS = 0xEE,
+    NEXTCHUNK = 0xEF,
     // Addition
     ADDC = 0x20,
     ADDS = 0x21,
@@ -318,7 +320,15 @@ enum
     GREADFILESHARE = 0x1BE,
     // Commsec ops
     INITSECURESOCKET = 0x1BA,
-    RESPSECURESOCKET = 0x1BB
+    RESPSECURESOCKET = 0x1BB,
+    // Superinstructions, only created by Program::fuse()
+    FUSED_LDINT_ADDINT = 0x400,
+    FUSED_LDINT_SUBINT = 0x401,
+    FUSED_LDINT_MULINT = 0x402,
+    FUSED_LDINT_LTC = 0x403,
+    FUSED_LDINT_LTC_JMPNZ = 0x404,
+    FUSED_LDMS_ADDS_STMS = 0x405,
+    FUSED_RUNTIME_CHECK = 0x406,
 };
 
 
@@ -343,6 +353,8 @@ struct TempVars {
   sint Sansp;
   bigint aa,aa2;
   typename sint::open_type rrp, xip;
+  // scratch space kept across instructions to avoid reallocation
+  vector<Integer> values;
 };
 
 
@@ -387,6 +399,9 @@ public:
   unsigned get_max_reg(int reg_type) const;
 
   string get_name() const;
+
+  // Returns the handler for threaded dispatch (see DispatchHandler)
+  int get_dispatch_handler() const;
 };
 
 class DataPositions;
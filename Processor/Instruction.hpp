@@ -153,6 +153,7 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
       case GPRINTREGPLAIN:
       case GPRINTREGPLAINS:
       case JOIN_TAPE:
+      case NEXTCHUNK:
       case PUSHINT:
       case POPINT:
       case PUBINPUT:
@@ -251,6 +252,7 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
       case RANDOMS:
       case GENSECSHUFFLE:
       case CALL_ARG:
+      case INITCHUNKS:
         r[0]=get_int(s);
         n = get_int(s);
         break;
@@ -597,6 +599,8 @@ int BaseInstruction::get_reg_type() const
     case GENSECSHUFFLE:
     case CMDLINEARG:
     case CALL_TAPE:
+    case INITCHUNKS:
+    case NEXTCHUNK:
       return INT;
     case PREP:
     case GPREP:
@@ -952,7 +956,9 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
   switch (opcode)
   {
     case CONVMODP:
-      vector<Integer> values;
+    {
+      auto& values = Proc.temp.values;
+      values.clear();
       values.reserve(size);
       for (int i = 0; i < size; i++)
       {
@@ -972,6 +978,7 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
       for (int i = 0; i < size; i++)
           Proc.write_Ci(r[0] + i, values[i].get());
       return;
+    }
   }
 
   int r[3] = {this->r[0], this->r[1], this->r[2]};
@@ -979,17 +986,6 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
   for (int i = 0; i < size; i++) 
   { switch (opcode)
     {
-      case LDMC:
-        Proc.write_Cp(r[0],Proc.machine.Mp.read_C(n));
-        n++;
-        break;
-      case STMC:
-        Proc.machine.Mp.write_C(n,Proc.read_Cp(r[0]));
-        n++;
-        break;
-      case MOVC:
-        Proc.write_Cp(r[0],Proc.read_Cp(r[1]));
-        break;
       case CONCATS:
         {
           auto& S = Proc.Procp.get_S();
@@ -1297,6 +1293,12 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
       case JOIN_TAPE:
         Proc.machine.join_tape(r[0]);
         break;
+      case INITCHUNKS:
+        Proc.machine.queues.chunks.reset(Proc.read_Ci(r[0]), n);
+        break;
+      case NEXTCHUNK:
+        Proc.write_Ci(r[0], Proc.machine.queues.chunks.next_chunk(Proc.P));
+        break;
       case CALL_TAPE:
         Proc.call_tape(r[0], Proc.read_Ci(r[1]), start);
         break;
@@ -1490,9 +1492,22 @@ void Program::execute(Processor<sint, sgf2n>& Proc) const
 template<class sint, class sgf2n>
 void Program::execute_with_errors(Processor<sint, sgf2n>& Proc) const
 {
+  bool profiling = not OnlineOptions::singleton.profile_prefix.empty();
+
+#ifdef THREADED_DISPATCH
+  if (not profiling)
+    {
+      execute_threaded(Proc);
+      return;
+    }
+#endif
+
   unsigned int size = p.size();
   Proc.PC=0;
 
+  if (profiling)
+    Proc.profiler.start(*this, Proc.profile_sample());
+
   auto& Procp = Proc.Procp;
   auto& Proc2 = Proc.Proc2;
 
@@ -1505,6 +1520,9 @@ void Program::execute_with_errors(Processor<sint, sgf2n>& Proc) const
 
   while (Proc.PC<size)
     {
+      if (profiling)
+        Proc.profiler.step(Proc.PC, Proc.profile_sample());
+
       Proc.last_PC = Proc.PC;
       auto& instruction = p[Proc.PC];
       auto& r = instruction.r;
@@ -1535,6 +1553,9 @@ void Program::execute_with_errors(Processor<sint, sgf2n>& Proc) const
         case NAME: { PRE; for (int i = 0; i < size; i++) { CODE; } } break;
         ARITHMETIC_INSTRUCTIONS
 #undef X
+#define X(NAME, PRE, CODE) case NAME: { PRE; CODE; } break;
+        FUSED_INSTRUCTIONS
+#undef X
 #define X(NAME, PRE, CODE) case NAME:
         CLEAR_GF2N_INSTRUCTIONS
         instruction.execute_clear_gf2n(Proc2.get_C(), Proc.machine.M2.MC, Proc); break;
@@ -1554,8 +1575,139 @@ void Program::execute_with_errors(Processor<sint, sgf2n>& Proc) const
       Proc.stats[p[PC].get_opcode()] += timer.elapsed() * 1e9;
 #endif
     }
+
+  if (profiling)
+    Proc.profiler.stop(Proc.profile_sample());
 }
 
+#ifdef THREADED_DISPATCH
+#ifdef TIME_INSTRUCTIONS
+#error "instruction timing requires switch dispatch"
+#endif
+
+template<class sint, class sgf2n>
+void Program::execute_threaded(Processor<sint, sgf2n>& Proc) const
+{
+  unsigned int size = p.size();
+  Proc.PC = 0;
+
+  auto& Procp = Proc.Procp;
+  auto& Proc2 = Proc.Proc2;
+
+  // binary instructions
+  typedef typename sint::bit_type T;
+  auto& processor = Proc.Procb;
+  auto& Ci = Proc.get_Ci();
+  auto& Mi = Proc.machine.Mi.MC;
+
+  BaseMachine::program = this;
+
+  // same order as DispatchHandler
+  static const void* const handlers[] = {
+      &&handler_OTHER,
+#define X(NAME, PRE, CODE) &&handler_##NAME,
+      ARITHMETIC_INSTRUCTIONS
+      REGINT_INSTRUCTIONS
+      FUSED_INSTRUCTIONS
+#undef X
+      &&handler_JMP,
+      &&handler_JMPNZ,
+      &&handler_JMPEQZ,
+      &&handler_CLEAR_GF2N,
+      &&handler_COMBI,
+  };
+  static_assert(sizeof(handlers) / sizeof(handlers[0]) == N_DISPATCH_HANDLERS,
+      "handler table out of sync");
+
+#ifdef COUNT_INSTRUCTIONS
+#define COUNT_INSTRUCTION Proc.stats[p[Proc.PC].get_opcode()]++;
+#else
+#define COUNT_INSTRUCTION
+#endif
+
+#ifdef OUTPUT_INSTRUCTIONS
+#define OUTPUT_INSTRUCTION \
+  if (OnlineOptions::singleton.has_option("output_instructions")) \
+    cerr << p[Proc.PC] << endl;
+#else
+#define OUTPUT_INSTRUCTION
+#endif
+
+  // every handler ends with its own indirect jump
+#define NEXT_INSTRUCTION \
+  if (Proc.PC >= size) \
+    return; \
+  Proc.last_PC = Proc.PC; \
+  COUNT_INSTRUCTION \
+  OUTPUT_INSTRUCTION \
+  goto *handlers[dispatch[Proc.PC++]];
+
+#define INSTRUCTION_OPERANDS \
+  auto& instruction = p[Proc.last_PC]; \
+  auto& r = instruction.r; \
+  auto& n = instruction.n; \
+  auto& start = instruction.start; \
+  auto& size = instruction.size; \
+  (void) r, (void) n, (void) start, (void) size;
+
+  NEXT_INSTRUCTION
+
+#define X(NAME, PRE, CODE) \
+  handler_##NAME: \
+  { INSTRUCTION_OPERANDS PRE; for (int i = 0; i < size; i++) { CODE; } } \
+  NEXT_INSTRUCTION
+  ARITHMETIC_INSTRUCTIONS
+  REGINT_INSTRUCTIONS
+#undef X
+
+#define X(NAME, PRE, CODE) \
+  handler_##NAME: \
+  { INSTRUCTION_OPERANDS PRE; CODE; } \
+  NEXT_INSTRUCTION
+  FUSED_INSTRUCTIONS
+#undef X
+
+handler_JMP:
+  Proc.PC += (signed int) p[Proc.last_PC].n;
+  NEXT_INSTRUCTION
+
+handler_JMPNZ:
+  if (Proc.read_Ci(p[Proc.last_PC].r[0]) != 0)
+    Proc.PC += (signed int) p[Proc.last_PC].n;
+  NEXT_INSTRUCTION
+
+handler_JMPEQZ:
+  if (Proc.read_Ci(p[Proc.last_PC].r[0]) == 0)
+    Proc.PC += (signed int) p[Proc.last_PC].n;
+  NEXT_INSTRUCTION
+
+handler_CLEAR_GF2N:
+  p[Proc.last_PC].execute_clear_gf2n(Proc2.get_C(), Proc.machine.M2.MC, Proc);
+  NEXT_INSTRUCTION
+
+handler_COMBI:
+  {
+    INSTRUCTION_OPERANDS
+    switch (instruction.get_opcode())
+      {
+#define X(NAME, CODE) case NAME: CODE; break;
+      COMBI_INSTRUCTIONS
+#undef X
+      }
+  }
+  NEXT_INSTRUCTION
+
+handler_OTHER:
+  p[Proc.last_PC].execute(Proc);
+  NEXT_INSTRUCTION
+
+#undef COUNT_INSTRUCTION
+#undef OUTPUT_INSTRUCTION
+#undef NEXT_INSTRUCTION
+#undef INSTRUCTION_OPERANDS
+}
+#endif
+
 template<class T>
 void Program::mulm_check() const
 {
@@ -0,0 +1,152 @@
+/*
+ * InstructionProfiler.cpp
+ *
+ */
+
+#include "InstructionProfiler.h"
+#include "Program.h"
+#include "Tools/Exceptions.h"
+
+#include <time.h>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+InstructionProfiler::Entry& InstructionProfiler::Entry::operator+=(
+        const Entry& other)
+{
+    calls += other.calls;
+    time += other.time;
+    data += other.data;
+    rounds += other.rounds;
+    prep += other.prep;
+    return *this;
+}
+
+long long InstructionProfiler::now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void InstructionProfiler::start(const Program& program, const Sample& sample)
+{
+    // tape called from another tape, the calling instruction only gets
+    // the cost outside the callee
+    if (current)
+    {
+        charge(sample, false);
+        stack.push_back({current, last});
+    }
+
+    auto& tape = tapes[program.get_name()];
+    if (tape.entries.size() != program.size())
+    {
+        tape.entries.clear();
+        tape.entries.resize(program.size());
+        tape.instructions.clear();
+        tape.locations.clear();
+        for (size_t i = 0; i < program.size(); i++)
+        {
+            tape.instructions.push_back(program.get_instruction_name(i));
+            tape.locations.push_back(program.get_location(i));
+        }
+    }
+
+    current = &tape.entries;
+    last = -1;
+    last_sample = sample;
+}
+
+void InstructionProfiler::stop(const Sample& sample)
+{
+    step(-1, sample);
+    if (stack.empty())
+        current = 0;
+    else
+    {
+        current = stack.back().first;
+        last = stack.back().second;
+        stack.pop_back();
+    }
+}
+
+InstructionProfiler& InstructionProfiler::operator+=(
+        InstructionProfiler& other)
+{
+    ScopeLock _(lock);
+    for (auto& x : other.tapes)
+    {
+        auto& mine = tapes[x.first];
+        if (mine.entries.size() != x.second.entries.size())
+            mine = x.second;
+        else
+            for (size_t i = 0; i < x.second.entries.size(); i++)
+                mine.entries[i] += x.second.entries[i];
+    }
+    return *this;
+}
+
+template<class T>
+void InstructionProfiler::write(const string& filename, T Entry::*metric,
+        const map<string, Entry>& stacks)
+{
+    ofstream out(filename);
+    if (out.fail())
+        throw file_error(filename);
+    for (auto& x : stacks)
+        if (x.second.*metric)
+            out << x.first << " " << x.second.*metric << endl;
+}
+
+void InstructionProfiler::output(const string& prefix, int my_num)
+{
+    // stacks for flame graphs: tape;source frames;instruction
+    map<string, Entry> stacks;
+    // table by location
+    map<string, Entry> locations;
+    for (auto& x : tapes)
+    {
+        auto& tape = x.second;
+        for (size_t i = 0; i < tape.entries.size(); i++)
+        {
+            auto& entry = tape.entries[i];
+            if (not entry.calls)
+                continue;
+            auto& location = tape.locations[i];
+            string frames = x.first;
+            if (not location.empty())
+                frames += ";" + location;
+            stacks[frames + ";" + tape.instructions[i]] += entry;
+            locations[location.empty() ? x.first : location] += entry;
+        }
+    }
+
+    string base = prefix + "-P" + to_string(my_num);
+    write(base + "-time.folded", &Entry::time, stacks);
+    write(base + "-bytes.folded", &Entry::data, stacks);
+    write(base + "-rounds.folded", &Entry::rounds, stacks);
+    write(base + "-prep.folded", &Entry::prep, stacks);
+
+    vector<pair<long long, string>> sorted;
+    for (auto& x : locations)
+        sorted.push_back({x.second.time, x.first});
+    sort(sorted.begin(), sorted.end(), greater<pair<long long, string>>());
+
+    string filename = base + ".txt";
+    ofstream out(filename);
+    if (out.fail())
+        throw file_error(filename);
+    out << "# time (s)\tdata (MB)\trounds\tprep\tcalls\tlocation" << endl;
+    for (auto& x : sorted)
+    {
+        auto& entry = locations[x.second];
+        out << entry.time * 1e-9 << "\t" << entry.data * 1e-6 << "\t"
+                << entry.rounds << "\t" << entry.prep << "\t" << entry.calls
+                << "\t" << x.second << endl;
+    }
+
+    cerr << "Profile written to " << base << "-*.folded and " << filename
+            << endl;
+}
@@ -0,0 +1,103 @@
+/*
+ * InstructionProfiler.h
+ *
+ */
+
+#ifndef PROCESSOR_INSTRUCTIONPROFILER_H_
+#define PROCESSOR_INSTRUCTIONPROFILER_H_
+
+#include "Tools/Lock.h"
+
+#include <map>
+#include <vector>
+#include <string>
+using namespace std;
+
+class Program;
+
+/**
+ * Time, communication, and preprocessing attributed to every
+ * instruction of every tape. The processor takes a sample before each
+ * instruction, and the difference to the previous sample is charged
+ * to the previous instruction.
+ */
+class InstructionProfiler
+{
+public:
+    struct Sample
+    {
+        long long time;
+        size_t data, rounds;
+        long long prep;
+    };
+
+    struct Entry
+    {
+        size_t calls;
+        long long time;
+        size_t data, rounds;
+        long long prep;
+
+        Entry() : calls(0), time(0), data(0), rounds(0), prep(0) {}
+        Entry& operator+=(const Entry& other);
+    };
+
+private:
+    // by tape name because programs might be reloaded
+    struct Tape
+    {
+        vector<Entry> entries;
+        vector<string> instructions, locations;
+    };
+
+    Lock lock;
+    map<string, Tape> tapes;
+
+    vector<Entry>* current;
+    int last;
+    Sample last_sample;
+
+    // callers of the current tape
+    vector<pair<vector<Entry>*, int>> stack;
+
+    void charge(const Sample& sample, bool count = true)
+    {
+        if (last >= 0)
+        {
+            auto& entry = (*current)[last];
+            entry.calls += count;
+            entry.time += sample.time - last_sample.time;
+            entry.data += sample.data - last_sample.data;
+            entry.rounds += sample.rounds - last_sample.rounds;
+            entry.prep += sample.prep - last_sample.prep;
+        }
+        last_sample = sample;
+    }
+
+    template<class T>
+    void write(const string& filename, T Entry::*metric,
+            const map<string, Entry>& stacks);
+
+public:
+    static long long now();
+
+    InstructionProfiler() : current(0), last(-1), last_sample() {}
+
+    void start(const Program& program, const Sample& sample);
+    void stop(const Sample& sample);
+
+    void step(int PC, const Sample& sample)
+    {
+        charge(sample);
+        last = PC;
+    }
+
+    bool empty() const { return tapes.empty(); }
+
+    InstructionProfiler& operator+=(InstructionProfiler& other);
+
+    // folded stacks for flame graphs and a table by location
+    void output(const string& prefix, int my_num);
+};
+
+#endif /* PROCESSOR_INSTRUCTIONPROFILER_H_ */
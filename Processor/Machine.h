@@ -14,6 +14,7 @@
 #include "Processor/Online-Thread.h"
 #include "Processor/ThreadJob.h"
 #include "Processor/ExternalClients.h"
+#include "Processor/InstructionProfiler.h"
 
 #include "Processor/FunctionArgument.h"
 
@@ -54,6 +55,9 @@ class Machine : public BaseMachine
 
   NamedCommStats max_comm;
 
+  // source of program names when serving
+  ifstream server_control;
+
   size_t load_program(const string& threadname, const string& filename);
 
   void prepare(const string& progname_str);
@@ -76,6 +80,7 @@ class Machine : public BaseMachine
   OnlineOptions opts;
 
   ExecutionStats stats;
+  InstructionProfiler profiler;
 
   ExternalClients external_clients;
 
@@ -106,6 +111,9 @@ class Machine : public BaseMachine
   void run(const string& progname);
 
   void run_step(const string& progname);
+  DataPositions serve(DataPositions pos);
+  bool next_program(string& progname);
+  void check_program_name(const string& progname);
   pair<DataPositions, NamedCommStats> stop_threads();
 
   void run_function(const string& name, FunctionArgument& result,
@@ -126,6 +134,9 @@ class Machine : public BaseMachine
   Player& get_player() { return *P; }
 
   void check_program();
+  void check_domain();
+  void check_domain(true_type);
+  void check_domain(false_type);
 };
 
 #endif /* MACHINE_H_ */
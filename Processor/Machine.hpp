@@ -11,10 +11,12 @@
 #include "Tools/Exceptions.h"
 
 #include <sys/time.h>
+#include <sys/stat.h>
 
 #include "Math/Setup.h"
 #include "Tools/mkpath.h"
 #include "Tools/Bundle.h"
+#include "Tools/Trace.h"
 
 #include <iostream>
 #include <vector>
@@ -60,6 +62,12 @@ Machine<sint, sgf2n>::Machine(Names& playerNames, bool use_encryption,
 {
   OnlineOptions::singleton = opts;
 
+  if (not opts.trace_prefix.empty())
+    {
+      Trace::activate();
+      Trace::name_thread("main");
+    }
+
   int min_players = 3 - sint::dishonest_majority;
   if (sint::is_real)
     {
@@ -157,6 +165,9 @@ void Machine<sint, sgf2n>::prepare(const string& progname_str)
 {
   int old_n_threads = nthreads;
   progs.clear();
+  // before parsing bytecode for a different domain
+  load_schedule(progname_str, false);
+  check_domain();
   load_schedule(progname_str);
   check_program();
 
@@ -413,6 +424,98 @@ void Machine<sint, sgf2n>::run_step(const string& progname)
   join_tape(0);
 }
 
+template<class sint, class sgf2n>
+DataPositions Machine<sint, sgf2n>::serve(DataPositions pos)
+{
+  string progname;
+  while (next_program(progname))
+    {
+      RunningTimer timer;
+      prepare(progname);
+      auto usage = run_tape(0, 0, 0, pos);
+      auto res = join_tape(0);
+      if (progs[0].usage_unknown())
+        pos = res;
+      else
+        pos.increase(usage);
+      cout.flush();
+      if (opts.verbose)
+        cerr << "Program " << progname << " took " << timer.elapsed()
+            << " seconds" << endl;
+    }
+
+  return pos;
+}
+
+template<class sint, class sgf2n>
+bool Machine<sint, sgf2n>::next_program(string& progname)
+{
+  // party 0 decides on the sequence of programs
+  octetStream os;
+  if (P->my_num() == 0)
+    {
+      progname.clear();
+      while (progname.empty())
+        {
+          if (not server_control.is_open())
+            {
+              server_control.open(opts.server_control);
+              if (server_control.fail())
+                throw file_error(opts.server_control);
+            }
+
+          getline(server_control, progname);
+
+          if (server_control.eof())
+            {
+              server_control.close();
+              // named pipes end with every writer, so wait for the next
+              struct stat info;
+              if (progname.empty() and
+                  (stat(opts.server_control.c_str(), &info) != 0
+                      or not S_ISFIFO(info.st_mode)))
+                progname = "exit";
+            }
+        }
+
+      os.store(progname);
+      P->send_all(os);
+    }
+  else
+    {
+      P->receive_player(0, os);
+      os.get(progname);
+    }
+
+  if (progname == "exit")
+    return false;
+
+  check_program_name(progname);
+  return true;
+}
+
+template<class sint, class sgf2n>
+void Machine<sint, sgf2n>::check_program_name(const string& progname)
+{
+  // names only refer to files in Programs/Schedules
+  if (progname.find('/') != string::npos
+      or progname.find("..") != string::npos)
+    throw runtime_error("invalid program name: " + progname);
+
+  if (opts.server_allowlist.empty())
+    return;
+
+  // every party checks against its own list
+  ifstream allowlist(opts.server_allowlist);
+  if (allowlist.fail())
+    throw file_error(opts.server_allowlist);
+  string allowed;
+  while (getline(allowlist, allowed))
+    if (allowed == progname)
+      return;
+  throw runtime_error("program not allowed: " + progname);
+}
+
 template<class sint, class sgf2n>
 void Machine<sint, sgf2n>::run_function(const string& name,
         FunctionArgument& result, vector<FunctionArgument>& arguments)
@@ -565,7 +668,17 @@ void Machine<sint, sgf2n>::run(const string& progname)
 
   // run main tape
   run_tape(0, 0, 0, N.num_players());
-  join_tape(0);
+  auto main_pos = join_tape(0);
+
+  auto expected = progs[0].get_offline_data_used();
+  bool usage_unknown = progs[0].usage_unknown();
+
+  // run further programs with the same setup
+  if (not opts.server_control.empty())
+    {
+      expected = serve(usage_unknown ? main_pos : expected);
+      usage_unknown = false;
+    }
 
   print_compiler();
 
@@ -659,8 +772,7 @@ void Machine<sint, sgf2n>::run(const string& progname)
       pos.print_cost();
     }
 
-  if (pos.any_more(progs[0].get_offline_data_used())
-      and not progs[0].usage_unknown())
+  if (pos.any_more(expected) and not usage_unknown)
     throw runtime_error("computation used more preprocessing than expected");
 
   if (not stats.empty())
@@ -668,10 +780,26 @@ void Machine<sint, sgf2n>::run(const string& progname)
       stats.print();
     }
 
+  if (not opts.profile_prefix.empty())
+    profiler.output(opts.profile_prefix, my_number);
+
+  if (not opts.trace_prefix.empty())
+    Trace::write(opts.trace_prefix + "-P" + to_string(my_number) + ".json");
+
+  if (opts.verbose)
+    {
+      ExecutionStats fusions;
+      for (auto& prog : progs)
+        fusions += prog.get_fusions();
+      if (not fusions.empty())
+        fusions.print("Superinstructions in bytecode");
+    }
+
   if (not opts.file_prep_per_thread)
     {
       Data_Files<sint, sgf2n> df(*this);
-      df.seekg(pos);
+      // served programs skip to the expected position
+      df.seekg(opts.server_control.empty() ? pos : expected);
       df.prune();
     }
 
@@ -768,4 +896,59 @@ void Machine<sint, sgf2n>::check_program()
   }
 }
 
+template<class sint, class sgf2n>
+void Machine<sint, sgf2n>::check_domain()
+{
+  // served programs might have been compiled for something else
+  check_domain(sint::clear::prime_field);
+
+  if (gf2n.substr(0, 4) == "lg2:")
+    {
+      int prog_lg2 = stoi(gf2n.substr(4));
+      if (prog_lg2 and prog_lg2 != sgf2n::clear::degree())
+        throw runtime_error(
+            progname + " was compiled for GF(2^" + to_string(prog_lg2)
+                + "), not GF(2^" + to_string(sgf2n::clear::degree()) + ")");
+    }
+}
+
+template<class sint, class sgf2n>
+void Machine<sint, sgf2n>::check_domain(true_type)
+{
+  if (domain.substr(0, 2) == "R:")
+    throw runtime_error(progname + " was compiled for a ring, "
+        "not a prime field");
+  else if (domain.substr(0, 2) == "p:")
+    {
+      if (bigint(domain.substr(2)) != sint::clear::pr())
+        throw runtime_error(progname + " was compiled for prime "
+            + domain.substr(2) + ", not " + sint::clear::pr().get_str());
+    }
+  else if (domain.substr(0, 4) == "lgp:")
+    {
+      int prog_lgp = stoi(domain.substr(4));
+      if (prog_lgp > sint::clear::length())
+        throw runtime_error(progname + " requires a prime of "
+            + to_string(prog_lgp) + " bits, not "
+            + to_string(sint::clear::length()));
+    }
+}
+
+template<class sint, class sgf2n>
+void Machine<sint, sgf2n>::check_domain(false_type)
+{
+  if (domain.substr(0, 2) == "p:"
+      or (domain.substr(0, 4) == "lgp:" and stoi(domain.substr(4))))
+    throw runtime_error(progname + " was compiled for a prime field, "
+        "not a ring");
+  else if (domain.substr(0, 2) == "R:")
+    {
+      int prog_R = stoi(domain.substr(2));
+      if (prog_R != sint::clear::length())
+        throw runtime_error(progname + " was compiled for "
+            + to_string(prog_R) + "-bit computation, not "
+            + to_string(sint::clear::length()) + "-bit");
+    }
+}
+
 #endif
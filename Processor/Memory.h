@@ -15,6 +15,7 @@ template<class T> istream& operator>>(istream& s,Memory<T>& M);
 #include "Processor/Program.h"
 #include "Tools/CheckVector.h"
 #include "Tools/DiskVector.h"
+#include "Tools/PagedVector.h"
 
 template<class T>
 class MemoryPart
@@ -43,6 +44,11 @@ public:
   virtual T& at(size_t i) = 0;
   virtual const T& at(size_t i) const = 0;
 
+  // whether access has to go through operator[] or touch_range()
+  virtual bool tracks_access() const { return false; }
+  // register access to n elements from start via pointer or data()
+  virtual void touch_range(size_t, size_t) const {}
+
   template<class U>
   void indirect_read(const Instruction& inst, StackedVector<T>& regs,
       const U& indices);
@@ -100,6 +106,21 @@ public:
     }
 };
 
+template<class T>
+class DiskMemoryPart : public MemoryPartImpl<T, DiskVector>
+{
+public:
+  bool tracks_access() const
+    {
+      return DiskVector<T>::tracks_access();
+    }
+
+  void touch_range(size_t start, size_t n) const
+    {
+      DiskVector<T>::touch_range(start, n);
+    }
+};
+
 template<class T> 
 class Memory
 {
@@ -108,6 +129,8 @@ class Memory
   MemoryPart<T>& MS;
   MemoryPartImpl<typename T::clear, CheckVector> MC;
 
+  static MemoryPart<T>* new_secret_part();
+
   Memory();
   ~Memory();
 
@@ -17,13 +17,17 @@ void MemoryPart<T>::indirect_read(const Instruction& inst,
   size_t size = this->size();
 #endif
   const T* data = this->data();
+  bool tracks_access = this->tracks_access();
   for (auto it = start; it < start + n; it++)
     {
 #ifndef NO_CHECK_SIZE
       if (size_t(it->get()) >= size)
         throw overflow(T::type_string() + " memory read", it->get(), size);
 #endif
-      *dest++ = data[it->get()];
+      if (tracks_access)
+        *dest++ = (*this)[it->get()];
+      else
+        *dest++ = data[it->get()];
     }
 }
 
@@ -41,13 +45,17 @@ void MemoryPart<T>::indirect_write(const Instruction& inst,
   size_t size = this->size();
 #endif
   T* data = this->data();
+  bool tracks_access = this->tracks_access();
   for (auto it = start; it < start + n; it++)
     {
 #ifndef NO_CHECK_SIZE
       if (size_t(it->get()) >= size)
         throw overflow(T::type_string() + " memory write", it->get(), size);
 #endif
-      data[it->get()] = *source++;
+      if (tracks_access)
+        (*this)[it->get()] = *source++;
+      else
+        data[it->get()] = *source++;
     }
 }
 
@@ -77,12 +85,21 @@ void MemoryPart<T>::minimum_size(size_t size)
   }
 }
 
+template<class T>
+MemoryPart<T>* Memory<T>::new_secret_part()
+{
+  auto& opts = OnlineOptions::singleton;
+  if (opts.disk_memory.size())
+    return new DiskMemoryPart<T>;
+  else if (opts.sparse_memory)
+    return new MemoryPartImpl<T, PagedVector>;
+  else
+    return new MemoryPartImpl<T, CheckVector>;
+}
+
 template<class T>
 Memory<T>::Memory() :
-    MS(
-        *(OnlineOptions::singleton.disk_memory.size() ?
-            static_cast<MemoryPart<T>*>(new MemoryPartImpl<T, DiskVector>) :
-            static_cast<MemoryPart<T>*>(new MemoryPartImpl<T, CheckVector>)))
+    MS(*new_secret_part())
 {
 }
 
@@ -81,6 +81,10 @@ template<class W>
 template<class T>
 void OfflineMachine<W>::generate()
 {
+    // nothing to store for disabled domains
+    if (not T::is_real)
+        return;
+
     T::clear::next::template init<typename T::clear>(false);
     T::clear::template write_setup<T>(P.num_players());
     auto mac_key = read_generate_write_mac_key<T>(P);
@@ -2,6 +2,7 @@
 #include "Processor/Program.h"
 #include "Processor/Online-Thread.h"
 #include "Tools/time-func.h"
+#include "Tools/Trace.h"
 #include "Processor/Data_Files.h"
 #include "Processor/Machine.h"
 #include "Processor/Processor.h"
@@ -42,6 +43,7 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
 
   int num=tinfo->thread_num;
   BaseMachine::s().thread_num = num;
+  Trace::name_thread("thread " + to_string(num));
 
   auto& queues = machine.queues[num];
   auto& opts = machine.opts;
@@ -127,7 +129,11 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
   while (flag)
     { // Wait until I have a program to run
       wait_timer.start();
-      ThreadJob job = queues->next();
+      ThreadJob job;
+      {
+        TraceScope trace("wait for job", "thread");
+        job = queues->next();
+      }
       program = job.prognum;
       wait_timer.stop();
 #ifdef DEBUG_THREADS
@@ -278,7 +284,10 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
              
           //printf("\tExecuting program");
           // Execute the program
-          progs[program].execute(Proc);
+          {
+            TraceScope trace(progs[program].get_name(), "tape");
+            progs[program].execute(Proc);
+          }
 
           // make sure values used in other threads are safe
           Proc.check();
@@ -350,6 +359,7 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
 
   // wind down thread by thread
   machine.stats += Proc.stats;
+  machine.profiler += Proc.profiler;
   queues->timers["wait"] = wait_timer + queues->wait_timer;
   timer.stop(P.total_comm());
   queues->timers["online"] = online_timer - online_prep_timer - queues->wait_timer;
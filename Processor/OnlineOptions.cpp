@@ -39,6 +39,8 @@ OnlineOptions::OnlineOptions() : playerno(-1)
     opening_sum = 0;
     max_broadcast = 0;
     receive_threads = false;
+    disk_memory_cache = 0;
+    sparse_memory = false;
     code_locations = false;
 #ifdef VERBOSE
     verbose = true;
@@ -462,6 +464,28 @@ void OnlineOptions::finalize_with_error(ez::ezOptionParser& opt)
     if (o)
         o->getString(disk_memory);
 
+    o = opt.get("--disk-memory-cache");
+    if (o)
+        o->getInt(disk_memory_cache);
+
+    sparse_memory = opt.isSet("--sparse-memory");
+
+    o = opt.get("--serve");
+    if (o)
+        o->getString(server_control);
+
+    o = opt.get("--serve-allow");
+    if (o)
+        o->getString(server_allowlist);
+
+    o = opt.get("--profile");
+    if (o)
+        o->getString(profile_prefix);
+
+    o = opt.get("--trace");
+    if (o)
+        o->getString(trace_prefix);
+
     receive_threads = opt.isSet("--threads");
 
     if (use_security_parameter)
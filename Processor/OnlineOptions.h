@@ -40,6 +40,12 @@ public:
     int opening_sum, max_broadcast;
     bool receive_threads;
     std::string disk_memory;
+    int disk_memory_cache;
+    bool sparse_memory;
+    std::string server_control;
+    std::string server_allowlist;
+    std::string profile_prefix;
+    std::string trace_prefix;
     vector<long> args;
     vector<string> options;
     string executable;
@@ -71,6 +71,75 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
               "--disk-memory" // Flag token.
         );
 
+        opt.add(
+              "0", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Keep at most this many MB of the memory on disk in RAM "
+              "(default: 0 for no limit)", // Help description.
+              "-DC", // Flag token.
+              "--disk-memory-cache" // Flag token.
+        );
+
+        opt.add(
+              "", // Default.
+              0, // Required?
+              0, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Only allocate secret memory (container data structures) "
+              "when written to", // Help description.
+              "-sm", // Flag token.
+              "--sparse-memory" // Flag token.
+        );
+
+        opt.add(
+              "", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Keep connections and setup after the program and run "
+              "further programs whose names party 0 reads line by line "
+              "from this file or named pipe until 'exit'", // Help description.
+              "-sv", // Flag token.
+              "--serve" // Flag token.
+        );
+
+        opt.add(
+              "", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Only run programs listed in this file (one per line) "
+              "when serving", // Help description.
+              "-sva", // Flag token.
+              "--serve-allow" // Flag token.
+        );
+
+        opt.add(
+              "", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Attribute time, communication, and preprocessing to "
+              "instructions and source locations (compile with -L) and "
+              "write the results to files starting with this prefix", // Help description.
+              "-PF", // Flag token.
+              "--profile" // Flag token.
+        );
+
+        opt.add(
+              "", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Record a timeline of tapes, communication, and "
+              "preprocessing per thread and write it in the Chrome trace "
+              "format to <prefix>-P<party>.json", // Help description.
+              "-TF", // Flag token.
+              "--trace" // Flag token.
+        );
+
         opt.add(
               to_string(V::default_degree()).c_str(), // Default.
               0, // Required?
@@ -39,6 +39,18 @@ public:
             throw prep_setup_error(e.what(), num_players, fake_opts);
         }
     }
+
+    void input(U* a, size_t n)
+    {
+        try
+        {
+            BufferOwner<T, U, V>::input(a, n);
+        }
+        catch (exception& e)
+        {
+            throw prep_setup_error(e.what(), num_players, fake_opts);
+        }
+    }
 };
 
 #endif /* PROCESSOR_PREPBUFFER_H_ */
@@ -22,8 +22,10 @@
 #include "GC/ShareThread.h"
 #include "Protocols/SecureShuffle.h"
 #include "Tools/NamedStats.h"
+#include "InstructionProfiler.h"
 
 class Program;
+class Conv2dTuple;
 
 // synchronize in asymmetric protocols
 template<class T>
@@ -40,6 +42,17 @@ class SubProcessor
 
   Binary_File_IO<T> binary_file_io;
 
+  // buffers for private communication, reused across calls
+  octetStreams personal_send, personal_receive;
+
+  // instruction arguments, reused across calls
+  vector<Conv2dTuple> conv2d_tuples;
+  struct
+  {
+    vector<size_t> sizes, destinations, sources, unit_sizes, shuffles;
+    vector<bool> reverse;
+  } shuffle_args;
+
   void resize(size_t size)       { C.resize(size); S.resize(size); }
 
   void matmulsm_prep(int ii, int j, const MemoryPart<T>& source,
@@ -160,6 +173,7 @@ public:
   ifstream private_input;
   ifstream public_input;
   ifstream binary_input;
+  vector<char> binary_input_buffer;
 
   int sent, rounds;
 
@@ -241,6 +255,9 @@ class Processor : public ArithmeticProcessor
   CommStats client_stats;
   Timer& client_timer;
 
+  // only used with --profile
+  InstructionProfiler profiler;
+
   void reset(const Program& program,int arg); // Reset the state of the processor
   string get_filename(const char* basename, bool use_number);
 
@@ -278,6 +295,8 @@ class Processor : public ArithmeticProcessor
 
   void check();
 
+  InstructionProfiler::Sample profile_sample();
+
   void dabit(const Instruction& instruction);
   void edabit(const Instruction& instruction, bool strict = false);
 
@@ -640,6 +640,7 @@ void SubProcessor<T>::matmulsm(const MemoryPart<T>& source,
 
     size_t sourceSize = source.size();
     const T* sourceData = source.data();
+    bool tracks_access = source.tracks_access();
 
     protocol.init_dotprod();
     for (auto matmulArgs = start.begin(); matmulArgs < start.end(); matmulArgs += 12) {
@@ -674,7 +675,10 @@ void SubProcessor<T>::matmulsm(const MemoryPart<T>& source,
                     assert(firstAddress < sourceSize);
                     assert(secondAddress < sourceSize);
 
-                    protocol.prepare_dotprod(sourceData[firstAddress], sourceData[secondAddress]);
+                    if (tracks_access)
+                        protocol.prepare_dotprod(source[firstAddress], source[secondAddress]);
+                    else
+                        protocol.prepare_dotprod(sourceData[firstAddress], sourceData[secondAddress]);
                 }
                 protocol.next_dotprod();
 
@@ -793,15 +797,19 @@ template<class T>
 void SubProcessor<T>::conv2ds(const Instruction& instruction)
 {
     auto& args = instruction.get_start();
-    vector<Conv2dTuple> tuples;
-    for (size_t i = 0; i < args.size(); i += 15)
-        tuples.push_back(Conv2dTuple(args, i));
+    auto& tuples = conv2d_tuples;
+    size_t n_tuples = args.size() / 15;
+    for (size_t i = 0; i < n_tuples; i++)
+        if (i < tuples.size())
+            tuples[i].reset(args, 15 * i);
+        else
+            tuples.push_back(Conv2dTuple(args, 15 * i));
     size_t done = 0;
-    while (done < tuples.size())
+    while (done < n_tuples)
     {
         protocol.init_dotprod();
         size_t i;
-        for (i = done; i < tuples.size() and protocol.get_buffer_size() <
+        for (i = done; i < n_tuples and protocol.get_buffer_size() <
                 OnlineOptions::singleton.batch_size; i++)
             tuples[i].pre(S, protocol);
         protocol.exchange();
@@ -814,6 +822,12 @@ void SubProcessor<T>::conv2ds(const Instruction& instruction)
 
 inline
 Conv2dTuple::Conv2dTuple(const vector<int>& arguments, int start)
+{
+    reset(arguments, start);
+}
+
+inline
+void Conv2dTuple::reset(const vector<int>& arguments, int start)
 {
     assert(arguments.size() >= start + 15ul);
     auto args = arguments.data() + start + 3;
@@ -828,7 +842,13 @@ Conv2dTuple::Conv2dTuple(const vector<int>& arguments, int start)
     r0 = arguments[start];
     r1 = arguments[start + 1];
     r2 = arguments[start + 2];
-    lengths.resize(batch_size, vector<vector<int>>(output_h, vector<int>(output_w)));
+    lengths.resize(batch_size);
+    for (auto& x : lengths)
+    {
+        x.resize(output_h);
+        for (auto& y : x)
+            y.assign(output_w, 0);
+    }
     filter_stride_h = 1;
     filter_stride_w = 1;
     if (stride_h < 0)
@@ -926,12 +946,15 @@ void SubProcessor<T>::apply_shuffle(const Instruction& instruction,
     const auto& args = instruction.get_start();
 
     const auto n_shuffles = args.size() / 6;
-    vector<size_t> sizes(n_shuffles, 0);
-    vector<size_t> destinations(n_shuffles, 0);
-    vector<size_t> sources(n_shuffles, 0);
-    vector<size_t> unit_sizes(n_shuffles, 0);
-    vector<size_t> shuffles(n_shuffles, 0);
-    vector<bool> reverse(n_shuffles, false);
+    auto& sizes = shuffle_args.sizes;
+    auto& destinations = shuffle_args.destinations;
+    auto& sources = shuffle_args.sources;
+    auto& unit_sizes = shuffle_args.unit_sizes;
+    auto& shuffles = shuffle_args.shuffles;
+    auto& reverse = shuffle_args.reverse;
+    for (auto x : {&sizes, &destinations, &sources, &unit_sizes, &shuffles})
+        x->assign(n_shuffles, 0);
+    reverse.assign(n_shuffles, false);
     for (size_t i = 0; i < n_shuffles; i++) {
         sizes[i] = args[6 * i];
         destinations[i] = args[6 * i + 1];
@@ -1008,7 +1031,10 @@ void SubProcessor<T>::private_output(const vector<int>& args)
 template<class T>
 void SubProcessor<T>::send_personal(const vector<int>& args)
 {
-  octetStreams to_send(P), to_receive(P);
+  auto& to_send = personal_send;
+  auto& to_receive = personal_receive;
+  to_send.reset(P);
+  to_receive.reset(P);
   for (size_t i = 0; i < args.size(); i += 5)
     if (args[i + 3] == P.my_num())
         for (int j = 0; j < args[i]; j++)
@@ -1020,6 +1046,13 @@ void SubProcessor<T>::send_personal(const vector<int>& args)
           C[args[i + 2] + j].unpack(to_receive[args[i + 3]]);
 }
 
+template<class sint, class sgf2n>
+InstructionProfiler::Sample Processor<sint, sgf2n>::profile_sample()
+{
+  return {InstructionProfiler::now(), P.total_sent(), P.total_rounds(),
+      DataF.usage.total()};
+}
+
 template<class sint, class sgf2n>
 typename sint::clear Processor<sint, sgf2n>::get_inverse2(unsigned m)
 {
@@ -1031,11 +1064,12 @@ typename sint::clear Processor<sint, sgf2n>::get_inverse2(unsigned m)
 template<class T, class U>
 void fixinput_int(T& proc, const Instruction& instruction, U)
 {
-  U* x = new U[instruction.get_size()];
-  proc.binary_input.read((char*) x, sizeof(U) * instruction.get_size());
+  auto& buffer = proc.binary_input_buffer;
+  buffer.resize(sizeof(U) * instruction.get_size());
+  U* x = (U*) buffer.data();
+  proc.binary_input.read(buffer.data(), buffer.size());
   for (int i = 0; i < instruction.get_size(); i++)
     proc.write_Cp(instruction.get_r(0) + i, x[i]);
-  delete[] x;
 }
 
 template<class sint, class sgf2n>
@@ -1103,7 +1137,8 @@ void Processor<sint, sgf2n>::fixinput(const Instruction& instruction)
 template<class sint, class sgf2n>
 long Processor<sint, sgf2n>::sync(long x)
 {
-  vector<Integer> tmp = {x};
+  auto& tmp = temp.values;
+  tmp.assign(1, x);
   Procp.protocol.sync(tmp, P);
   return tmp[0].get();
 }
@@ -1114,7 +1149,8 @@ void ProtocolBase<sint>::sync(vector<U>& x, Player& P)
 {
   if (not sint::symmetric)
     {
-      octetStream os;
+      thread_local octetStream os;
+      os.reset_write_head();
       // send number to dealer
       if (P.my_num() == 0)
         {
@@ -5,6 +5,8 @@
 
 #include "Processor/Instruction.hpp"
 
+#include <set>
+
 void Program::compute_constants()
 {
   bool debug = OnlineOptions::singleton.has_option("debug_alloc");
@@ -83,6 +85,18 @@ void Program::parse_with_error(string filename)
       hasher.update(buf, n);
     }
   hash = hasher.final().str();
+
+  locations.clear();
+  if (not OnlineOptions::singleton.profile_prefix.empty())
+    {
+      ifstream loc_file(
+          boost::filesystem::path(filename).replace_extension(".loc").string());
+      string location;
+      while (getline(loc_file, location))
+        locations.push_back(location == "-" ? "" : location);
+      if (loc_file.is_open() and locations.size() != p.size())
+        throw runtime_error("source locations don't match " + filename);
+    }
 }
 
 void Program::parse(istream& s)
@@ -120,6 +134,102 @@ void Program::parse(istream& s)
       s.peek();
     }
   compute_constants();
+  fuse();
+
+  dispatch.clear();
+  for (auto& instr : p)
+    dispatch.push_back(instr.get_dispatch_handler());
+}
+
+void Program::fuse()
+{
+  fusions.clear();
+
+  // profiling attributes to every instruction separately
+  if (OnlineOptions::singleton.has_option("no_fusion")
+      or not OnlineOptions::singleton.profile_prefix.empty())
+    return;
+
+  auto scalar = [&](size_t i, int opcode)
+    {
+      return i < p.size() and p[i].opcode == opcode and p[i].size == 1;
+    };
+
+  // The compiler guards memory accesses by printing a message and
+  // crashing if a regint is non-zero. Returns the offset of the crash
+  // if such a block starts at i.
+  auto runtime_check = [&](size_t i) -> size_t
+    {
+      int condition = p[i].r[1];
+      set<int> copies;
+      for (size_t j = i; j < p.size() and p[j].size == 1; j++)
+        switch (p[j].opcode)
+          {
+        case CONVINT:
+          if (p[j].r[1] == condition)
+            copies.insert(p[j].r[0]);
+          else
+            copies.erase(p[j].r[0]);
+          break;
+        case LDI:
+          copies.erase(p[j].r[0]);
+          break;
+        case CONDPRINTSTR:
+        case CONDPRINTPLAIN:
+          if (not copies.count(p[j].r[0]))
+            return 0;
+          break;
+        case CRASH:
+          return p[j].r[0] == condition ? j - i : 0;
+        default:
+          return 0;
+          }
+      return 0;
+    };
+
+  for (size_t i = 0; i < p.size(); i++)
+    {
+      int fused = 0;
+      int length = 2;
+      if (scalar(i, LDINT))
+        {
+          if (scalar(i + 1, LTC) and scalar(i + 2, JMPNZ))
+            {
+              fused = FUSED_LDINT_LTC_JMPNZ;
+              length = 3;
+            }
+          else if (scalar(i + 1, ADDINT))
+            fused = FUSED_LDINT_ADDINT;
+          else if (scalar(i + 1, SUBINT))
+            fused = FUSED_LDINT_SUBINT;
+          else if (scalar(i + 1, MULINT))
+            fused = FUSED_LDINT_MULINT;
+          else if (scalar(i + 1, LTC))
+            fused = FUSED_LDINT_LTC;
+        }
+      else if (scalar(i, LDMS) and scalar(i + 1, ADDS) and scalar(i + 2, STMS))
+        {
+          fused = FUSED_LDMS_ADDS_STMS;
+          length = 3;
+        }
+      else if (scalar(i, CONVINT))
+        {
+          size_t offset = runtime_check(i);
+          if (offset)
+            {
+              fused = FUSED_RUNTIME_CHECK;
+              length = offset + 1;
+              p[i].n = offset;
+            }
+        }
+
+      if (fused)
+        {
+          p[i].opcode = fused;
+          fusions[fused]++;
+          i += length - 1;
+        }
+    }
 }
 
 void Program::print_offline_cost() const
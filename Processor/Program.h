@@ -3,6 +3,7 @@
 
 #include "Processor/Instruction.h"
 #include "Processor/Data_Files.h"
+#include "Tools/ExecutionStats.h"
 
 template<class sint, class sgf2n> class Machine;
 
@@ -11,6 +12,8 @@ template<class sint, class sgf2n> class Machine;
 class Program
 {
   vector<Instruction> p;
+  // Handler per instruction for threaded dispatch
+  vector<unsigned short> dispatch;
   // Here we note the number of bits, squares and triples and input
   // data needed
   //  - This is computed for a whole program sequence to enable
@@ -30,8 +33,17 @@ class Program
 
   string name;
 
+  // Number of superinstructions by opcode
+  ExecutionStats fusions;
+
+  // Source location per instruction if compiled with -L
+  vector<string> locations;
+
   void compute_constants();
 
+  // Replace frequent sequences by superinstructions
+  void fuse();
+
   public:
 
   bool writes_persistence;
@@ -61,6 +73,18 @@ class Program
   const string& get_hash() const
     { return hash; }
 
+  const ExecutionStats& get_fusions() const
+    { return fusions; }
+
+  const string& get_name() const
+    { return name; }
+
+  string get_instruction_name(size_t i) const
+    { return p.at(i).get_name(); }
+
+  string get_location(size_t i) const
+    { return i < locations.size() ? locations[i] : ""; }
+
   friend ostream& operator<<(ostream& s,const Program& P);
 
   // Execute this program, updateing the processor and memory
@@ -71,6 +95,11 @@ class Program
   template<class sint, class sgf2n>
   void execute_with_errors(Processor<sint, sgf2n>& Proc) const;
 
+  // Jump directly from handler to handler instead of a central switch,
+  // used with THREADED_DISPATCH
+  template<class sint, class sgf2n>
+  void execute_threaded(Processor<sint, sgf2n>& Proc) const;
+
   template<class T>
   void mulm_check() const;
 };
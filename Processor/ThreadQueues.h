@@ -9,6 +9,7 @@
 #include "Tools/WaitQueue.h"
 #include "ThreadJob.h"
 #include "ThreadQueue.h"
+#include "ChunkPool.h"
 
 class ThreadQueues :
         public vector<ThreadQueue*>
@@ -16,6 +17,9 @@ class ThreadQueues :
     vector<int> available;
 
 public:
+    // work distribution for the tapes started by the main thread
+    ChunkPool chunks;
+
     int find_available();
     int get_n_per_thread(int n_items, int granularity = 1);
     // expects that the last slice is done by the caller
@@ -14,9 +14,17 @@
     X(LDSI, auto dest = &Procp.get_S()[r[0]]; \
             auto tmp = sint::constant(int(n), Proc.P.my_num(), Procp.MC.get_alphai()), \
             *dest++ = tmp) \
-    X(LDMS, auto dest = &Procp.get_S()[r[0]]; auto source = &Proc.machine.Mp.MS[n], \
+    X(LDMS, auto dest = &Procp.get_S()[r[0]]; auto source = &Proc.machine.Mp.MS[n]; \
+            Proc.machine.Mp.MS.touch_range(n, size), \
             *dest++ = *source++) \
-    X(STMS, auto source = &Procp.get_S()[r[0]]; auto dest = &Proc.machine.Mp.MS[n], \
+    X(STMS, auto source = &Procp.get_S()[r[0]]; auto dest = &Proc.machine.Mp.MS[n]; \
+            Proc.machine.Mp.MS.touch_range(n, size), \
+            *dest++ = *source++) \
+    X(LDMC, auto dest = &Procp.get_C()[r[0]]; auto source = &Proc.machine.Mp.MC[n]; \
+            Proc.machine.Mp.MC.touch_range(n, size), \
+            *dest++ = *source++) \
+    X(STMC, auto source = &Procp.get_C()[r[0]]; auto dest = &Proc.machine.Mp.MC[n]; \
+            Proc.machine.Mp.MC.touch_range(n, size), \
             *dest++ = *source++) \
     X(LDMSI, Proc.machine.Mp.MS.indirect_read(instruction, Procp.get_S(), Proc.get_Ci()),) \
     X(STMSI, Proc.machine.Mp.MS.indirect_write(instruction, Procp.get_S(), Proc.get_Ci()),) \
@@ -24,6 +32,8 @@
     X(STMCI, Proc.machine.Mp.MC.indirect_write(instruction, Procp.get_C(), Proc.get_Ci()),) \
     X(MOVS, auto dest = &Procp.get_S()[r[0]]; auto source = &Procp.get_S()[r[1]], \
             *dest++ = *source++) \
+    X(MOVC, auto dest = &Procp.get_C()[r[0]]; auto source = &Procp.get_C()[r[1]], \
+            *dest++ = *source++) \
     X(ADDS, auto dest = &Procp.get_S()[r[0]]; auto op1 = &Procp.get_S()[r[1]]; \
             auto op2 = &Procp.get_S()[r[2]], \
             *dest++ = *op1++ + *op2++) \
@@ -67,12 +77,10 @@
             s += *op1++; *dest++ = s) \
     X(PICKS, auto dest = &Procp.get_S()[r[0]]; auto op1 = &Procp.get_S()[r[1] + r[2]], \
             *dest++ = *op1; op1 += int(n)) \
-    X(MULM, auto dest = &Procp.get_S()[r[0]]; auto op1 = &Procp.get_S()[r[1]]; \
-            auto op2 = &Procp.get_C()[r[2]]; mulm_check<sint>(), \
-            *dest++ = *op1++ * *op2++) \
-    X(MULC, auto dest = &Procp.get_C()[r[0]]; auto op1 = &Procp.get_C()[r[1]]; \
-            auto op2 = &Procp.get_C()[r[2]], \
-            *dest++ = *op1++ * *op2++) \
+    X(MULM, mulm_check<sint>(); sint::mul_batch(&Procp.get_S()[r[0]], \
+            &Procp.get_S()[r[1]], &Procp.get_C()[r[2]], size),) \
+    X(MULC, sint::clear::mul_batch(&Procp.get_C()[r[0]], &Procp.get_C()[r[1]], \
+            &Procp.get_C()[r[2]], size),) \
     X(MULCI, auto dest = &Procp.get_C()[r[0]]; auto op1 = &Procp.get_C()[r[1]]; \
             typename sint::clear op2 = int(n), \
             *dest++ = *op1++ * op2) \
@@ -117,9 +125,11 @@
     X(GLDSI, auto dest = &Proc2.get_S()[r[0]]; \
             auto tmp = sgf2n::constant(int(n), Proc.P.my_num(), Proc2.MC.get_alphai()), \
             *dest++ = tmp) \
-    X(GLDMS, auto dest = &Proc2.get_S()[r[0]]; auto source = &Proc.machine.M2.MS[n], \
+    X(GLDMS, auto dest = &Proc2.get_S()[r[0]]; auto source = &Proc.machine.M2.MS[n]; \
+            Proc.machine.M2.MS.touch_range(n, size), \
             *dest++ = *source++) \
-    X(GSTMS, auto source = &Proc2.get_S()[r[0]]; auto dest = &Proc.machine.M2.MS[n], \
+    X(GSTMS, auto source = &Proc2.get_S()[r[0]]; auto dest = &Proc.machine.M2.MS[n]; \
+            Proc.machine.M2.MS.touch_range(n, size), \
             *dest++ = *source++) \
     X(GLDMSI, Proc.machine.M2.MS.indirect_read(instruction, Proc2.get_S(), Proc.get_Ci()),) \
     X(GSTMSI, Proc.machine.M2.MS.indirect_write(instruction, Proc2.get_S(), Proc.get_Ci()),) \
@@ -169,8 +179,8 @@
             *dest++ = (*source).get(); source++) \
     X(STMINT, auto dest = &Mi[n]; auto source = &Proc.get_Ci()[r[0]], \
             *dest++ = *source++) \
-    X(LDMINTI, Mi.indirect_read(*this, Proc.get_Ci(), Proc.get_Ci()),) \
-    X(STMINTI, Mi.indirect_write(*this, Proc.get_Ci(), Proc.get_Ci()),) \
+    X(LDMINTI, Mi.indirect_read(instruction, Proc.get_Ci(), Proc.get_Ci()),) \
+    X(STMINTI, Mi.indirect_write(instruction, Proc.get_Ci(), Proc.get_Ci()),) \
     X(MOVINT, auto dest = &Proc.get_Ci()[r[0]]; auto source = &Ci[r[1]], \
             *dest++ = *source++) \
     X(PUSHINT, Proc.pushi(Ci[r[0]]),) \
@@ -206,8 +216,8 @@
     X(PRINTFLOATPREC, Proc.out << setprecision(n),) \
     X(PRINTSTR, Proc.out << string((char*)&n,4) << flush,) \
     X(PRINTCHR, Proc.out << string((char*)&n,1) << flush,) \
-    X(SHUFFLE, shuffle(Proc),) \
-    X(BITDECINT, bitdecint(Proc),) \
+    X(SHUFFLE, instruction.shuffle(Proc),) \
+    X(BITDECINT, instruction.bitdecint(Proc),) \
     X(RAND, auto dest = &Ci[r[0]]; auto source = &Ci[r[1]], \
             *dest++ = Proc.shared_prng.get_uint() % (1 << (*source++).get())) \
 
@@ -281,9 +291,6 @@
 
 #define REMAINING_INSTRUCTIONS \
     X(CONVMODP, throw not_implemented(),) \
-    X(LDMC, throw not_implemented(),) \
-    X(STMC, throw not_implemented(),) \
-    X(MOVC, throw not_implemented(),) \
     X(DIVC, throw not_implemented(),) \
     X(GDIVC, throw not_implemented(),) \
     X(FLOORDIVC, throw not_implemented(),) \
@@ -348,6 +355,8 @@
     X(STOP, throw not_implemented(),) \
     X(RUN_TAPE, throw not_implemented(),) \
     X(JOIN_TAPE, throw not_implemented(),) \
+    X(INITCHUNKS, throw not_implemented(),) \
+    X(NEXTCHUNK, throw not_implemented(),) \
     X(CRASH, throw not_implemented(),) \
     X(STARTGRIND, throw not_implemented(),) \
     X(STOPGRIND, throw not_implemented(),) \
@@ -395,7 +404,58 @@
     X(GWRITEFILESHARE, throw not_implemented(),) \
     X(GREADFILESHARE, throw not_implemented(),) \
 
+// The head of a fused sequence executes the following instructions as
+// well, which stay in place as jump targets. A runtime check only sets
+// the clear registers if its regint is zero, and it keeps the offset of
+// the final crash in n.
+#define FUSED_INSTRUCTIONS \
+    X(FUSED_LDINT_ADDINT, auto& op = p[Proc.PC++], \
+            Ci[r[0]] = int(n); Ci[op.r[0]] = Ci[op.r[1]] + Ci[op.r[2]]) \
+    X(FUSED_LDINT_SUBINT, auto& op = p[Proc.PC++], \
+            Ci[r[0]] = int(n); Ci[op.r[0]] = Ci[op.r[1]] - Ci[op.r[2]]) \
+    X(FUSED_LDINT_MULINT, auto& op = p[Proc.PC++], \
+            Ci[r[0]] = int(n); Ci[op.r[0]] = Ci[op.r[1]] * Ci[op.r[2]]) \
+    X(FUSED_LDINT_LTC, auto& op = p[Proc.PC++], \
+            Ci[r[0]] = int(n); Ci[op.r[0]] = Ci[op.r[1]] < Ci[op.r[2]]) \
+    X(FUSED_LDINT_LTC_JMPNZ, auto& op = p[Proc.PC]; auto& jump = p[Proc.PC + 1]; \
+            Proc.PC += 2, \
+            Ci[r[0]] = int(n); Ci[op.r[0]] = Ci[op.r[1]] < Ci[op.r[2]]; \
+            if (Proc.read_Ci(jump.r[0]) != 0) Proc.PC += (signed int) jump.n) \
+    X(FUSED_LDMS_ADDS_STMS, auto& add = p[Proc.PC]; auto& store = p[Proc.PC + 1]; \
+            auto& S = Procp.get_S(); auto& MS = Proc.machine.Mp.MS; \
+            Proc.PC += 2, \
+            S[r[0]] = MS[n]; S[add.r[0]] = S[add.r[1]] + S[add.r[2]]; \
+            MS[store.n] = S[store.r[0]]) \
+    X(FUSED_RUNTIME_CHECK, auto& C = Procp.get_C(); auto end = Proc.PC + n, \
+            C[r[0]] = Ci[r[1]]; \
+            if (Ci[r[1]] == 0) \
+                for (; Proc.PC < end; Proc.PC++) \
+                { \
+                    auto& op = p[Proc.PC]; \
+                    if (op.opcode == CONVINT) \
+                        C[op.r[0]] = Ci[op.r[1]]; \
+                    else if (op.opcode == LDI) \
+                        C[op.r[0]] = typename sint::clear(int(op.n)); \
+                }) \
+
 #define ALL_INSTRUCTIONS ARITHMETIC_INSTRUCTIONS REGINT_INSTRUCTIONS \
-    CLEAR_GF2N_INSTRUCTIONS REMAINING_INSTRUCTIONS
+    CLEAR_GF2N_INSTRUCTIONS REMAINING_INSTRUCTIONS FUSED_INSTRUCTIONS
+
+// handlers for threaded dispatch, see Program::execute_threaded()
+enum DispatchHandler
+{
+    DISPATCH_OTHER,
+#define X(NAME, PRE, CODE) DISPATCH_##NAME,
+    ARITHMETIC_INSTRUCTIONS
+    REGINT_INSTRUCTIONS
+    FUSED_INSTRUCTIONS
+#undef X
+    DISPATCH_JMP,
+    DISPATCH_JMPNZ,
+    DISPATCH_JMPEQZ,
+    DISPATCH_CLEAR_GF2N,
+    DISPATCH_COMBI,
+    N_DISPATCH_HANDLERS
+};
 
 #endif /* PROCESSOR_INSTRUCTIONS_H_ */
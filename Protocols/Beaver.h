@@ -34,6 +34,12 @@ protected:
     Preprocessing<T>* prep;
     typename T::MAC_Check* MC;
 
+    // products with the opened values for all triples
+    vector<T> products;
+    vector<typename T::open_type> open_products;
+
+    void multiply_opened();
+
 public:
     static const bool uses_triples = true;
 
@@ -63,8 +63,7 @@ void Beaver<T>::exchange()
     MC->exchange(P);
     for (size_t i = 0; i < shares.size(); i++)
         opened.push_back(MC->finalize_raw());
-    it = opened.begin();
-    triple = triples.begin();
+    multiply_opened();
 }
 
 template<class T>
@@ -77,6 +76,26 @@ template<class T>
 void Beaver<T>::stop_exchange()
 {
     MC->POpen_End(opened, shares, P);
+    multiply_opened();
+}
+
+template<class T>
+void Beaver<T>::multiply_opened()
+{
+    // all products at once to allow vectorization
+    size_t n = triples.size();
+    assert(opened.size() == 2 * n);
+    products.resize(2 * n);
+    open_products.resize(n);
+    if (n)
+    {
+        auto masked = opened.data();
+        T::mul_batch(products.data(), &triples[0][1], masked, n, 2, 3, 2);
+        T::mul_batch(products.data() + 1, &triples[0][0], masked + 1, n, 2,
+                3, 2);
+        T::open_type::mul_batch(open_products.data(), masked, masked + 1, n,
+                1, 2, 2);
+    }
     it = opened.begin();
     triple = triples.begin();
 }
@@ -85,15 +104,12 @@ template<class T>
 T Beaver<T>::finalize_mul(int n)
 {
     this->add_mul(n);
-    typename T::open_type masked[2];
+    size_t i = triple - triples.begin();
     T& tmp = (*triple)[2];
-    for (int k = 0; k < 2; k++)
-    {
-        masked[k] = *it++;
-    }
-    tmp += (masked[0] * (*triple)[1]);
-    tmp += ((*triple)[0] * masked[1]);
-    tmp += T::constant(masked[0] * masked[1], P.my_num(), MC->get_alphai());
+    tmp += products[2 * i];
+    tmp += products[2 * i + 1];
+    tmp += T::constant(open_products[i], P.my_num(), MC->get_alphai());
+    it += 2;
     triple++;
     return tmp;
 }
@@ -118,6 +118,14 @@ Coordinator* Tree_MAC_Check<U>::coordinator = 0;
 template<class U>
 class MAC_Check_ : public virtual Tree_MAC_Check<U>
 {
+  typedef typename U::open_type T;
+  typedef typename U::mac_type mac_type;
+
+  // random linear combination of values and MACs,
+  // vectorized if all are of the same type
+  void combine(mac_type& a, mac_type& gami, PRNG& G, true_type);
+  void combine(mac_type& a, mac_type& gami, PRNG& G, false_type);
+
 public:
   MAC_Check_(const typename U::mac_key_type::Scalar& ai, int opening_sum = 10,
       int max_broadcast = 10, int send_player = 0);
@@ -157,6 +157,48 @@ void mac_fail_remove(const Player& P)
   throw mac_fail();
 }
 
+template<class U>
+void MAC_Check_<U>::combine(mac_type& a, mac_type& gami, PRNG& G, true_type)
+{
+  auto& vals = this->vals;
+  auto& macs = this->macs;
+  int popen_cnt = this->popen_cnt;
+
+  // in chunks to limit the memory usage
+  const int chunk_size = 1024;
+  vector<T> coeffs(min(popen_cnt, chunk_size));
+  vector<T> val_products(coeffs.size()), mac_products(coeffs.size());
+  for (int i = 0; i < popen_cnt; i += chunk_size)
+    {
+      int n = min(chunk_size, popen_cnt - i);
+      for (int j = 0; j < n; j++)
+        coeffs[j].almost_randomize(G);
+      T::mul_batch(val_products.data(), &vals[i], coeffs.data(), n);
+      T::mul_batch(mac_products.data(), &macs[i], coeffs.data(), n);
+      for (int j = 0; j < n; j++)
+        {
+          a += val_products[j];
+          gami += mac_products[j];
+        }
+    }
+}
+
+template<class U>
+void MAC_Check_<U>::combine(mac_type& a, mac_type& gami, PRNG& G, false_type)
+{
+  mac_type temp;
+  typename mac_type::Scalar h;
+  for (int i = 0; i < this->popen_cnt; i++)
+    {
+      h.almost_randomize(G);
+      temp = this->vals[i] * h;
+      a = (a + temp);
+
+      temp = h * this->macs[i];
+      gami = (gami + temp);
+    }
+}
+
 template<class U>
 void MAC_Check_<U>::Check(const Player& P)
 {
@@ -209,17 +251,10 @@ void MAC_Check_<U>::Check(const Player& P)
 
       U sj;
       typename U::mac_type a,gami,temp;
-      typename U::mac_type::Scalar h;
       vector<typename U::mac_type> tau(P.num_players());
-      for (int i=0; i<popen_cnt; i++)
-        {
-          h.almost_randomize(G);
-          temp = vals[i] * h;
-          a = (a + temp);
-
-          temp = h * macs[i];
-          gami = (gami + temp);
-        }
+      combine(a, gami, G,
+          integral_constant<bool, is_same<T, mac_type>::value and
+          is_same<T, typename mac_type::Scalar>::value>());
 
       temp = this->alphai * a;
       tau[P.my_num()] = (gami - temp);
@@ -9,17 +9,6 @@
 #include "Tools/Commit.h"         // For cryptographic operations
 #include "Networking/Player.h"    // For communication
 #include "PPMLAC_protocol.h"
-#include <iomanip> 
-
-// Improved hex conversion for debugging
-std::string to_hex(const octet* data, size_t length) {
-    std::stringstream ss;
-    for (size_t i = 0; i < length; i++) {
-        ss << std::hex << std::setw(2) << std::setfill('0') 
-           << static_cast<int>(data[i]);
-    }
-    return ss.str();
-}
 
 template<class T> class SubProcessor;
 class DataPositions;
@@ -28,7 +17,14 @@ class DataPositions;
 template<class T>
 class PPMLACPrep : public BufferPrep<T>
 {
-    Player& player;
+    typename T::Protocol* protocol;
+
+    PRNG& get_prng()
+    {
+        assert(protocol);
+        return protocol->synchronized_prng;
+    }
+
 public:
     // global setup for encryption keys if needed
     static void basic_setup(Player& player)
@@ -38,87 +34,95 @@ public:
 
         if (player.my_num() == 0) {
             // Alice (P0)
+#ifdef DEBUG_PPMLAC
             std::cerr << "Alice starting Protocol 2 setup..." << std::endl;
+#endif
             
             // Step 3: Generate random m
             PRNG temp_rng;
             temp_rng.ReSeed();
             octet m_oct[seed_size];
             temp_rng.get_octets(m_oct, seed_size);
-            std::cerr << "Alice generated m: " << to_hex(m_oct, seed_size) << std::endl;
 
             // Step 5: Send m to Bob
             octetStream os_send;
             os_send.append(m_oct, seed_size);
             player.send_to(other_party, os_send);
+#ifdef DEBUG_PPMLAC
             std::cerr << "Alice sent m to Bob" << std::endl;
+#endif
 
             // Step 7: Receive TR from Bob
             octetStream os_recv;
             player.receive_player(other_party, os_recv);
+#ifdef DEBUG_PPMLAC
             std::cerr << "Alice received TR: " << os_recv.get_length() << " bytes" << std::endl;
+#endif
             
             if (os_recv.get_length() < seed_size) {
-                std::cerr << "Error: Received TR of insufficient length" << std::endl;
                 throw runtime_error("Received TR of insufficient length");
             }
             
             octet TR_oct[seed_size];
             os_recv.consume(TR_oct, seed_size);
-            std::cerr << "Alice received TR: " << to_hex(TR_oct, seed_size) << std::endl;
 
             // Derive seed = m XOR TR
             octet derived_seed[seed_size];
             for (int i = 0; i < seed_size; i++) {
                 derived_seed[i] = m_oct[i] ^ TR_oct[i];
             }
-            std::cerr << "Alice derived seed: " << to_hex(derived_seed, seed_size) << std::endl;
 
-            // Initialize synchronized PRNG
-            PPMLACProtocol<T>::synchronized_prng.SetSeed(derived_seed);
-            std::cerr << "Alice initialized synchronized PRNG" << std::endl;
+            // Protocol instances derive their PRNGs from this
+            memcpy(PPMLACSetup::seed, derived_seed, seed_size);
+#ifdef DEBUG_PPMLAC
+            std::cerr << "Alice stored setup seed" << std::endl;
+#endif
         }
         else if (player.my_num() == 1) {
             // Bob (P1)
+#ifdef DEBUG_PPMLAC
             std::cerr << "Bob starting Protocol 2 setup..." << std::endl;
+#endif
             
             // Step 5: Receive m from Alice
             octetStream os_recv;
             player.receive_player(other_party, os_recv);
+#ifdef DEBUG_PPMLAC
             std::cerr << "Bob received m: " << os_recv.get_length() << " bytes" << std::endl;
+#endif
             
             if (os_recv.get_length() < seed_size) {
-                std::cerr << "Error: Received m of insufficient length" << std::endl;
                 throw runtime_error("Received m of insufficient length");
             }
             
             octet m_oct[seed_size];
             os_recv.consume(m_oct, seed_size);
-            std::cerr << "Bob received m: " << to_hex(m_oct, seed_size) << std::endl;
 
             // Generate random TR
             PRNG temp_rng;
             temp_rng.ReSeed();
             octet TR_oct[seed_size];
             temp_rng.get_octets(TR_oct, seed_size);
-            std::cerr << "Bob generated TR: " << to_hex(TR_oct, seed_size) << std::endl;
 
             // Step 7: Send TR to Alice
             octetStream os_send;
             os_send.append(TR_oct, seed_size);
             player.send_to(other_party, os_send);
+#ifdef DEBUG_PPMLAC
             std::cerr << "Bob sent TR to Alice" << std::endl;
+#endif
 
             // Derive seed = m XOR TR
             octet derived_seed[seed_size];
             for (int i = 0; i < seed_size; i++) {
                 derived_seed[i] = m_oct[i] ^ TR_oct[i];
             }
-            std::cerr << "Bob derived seed: " << to_hex(derived_seed, seed_size) << std::endl;
 
-            // Initialize synchronized PRNG
-            PPMLACProtocol<T>::synchronized_prng.SetSeed(derived_seed);
-            std::cerr << "Bob initialized synchronized PRNG" << std::endl;
+            // Protocol instances derive their PRNGs from this
+            memcpy(PPMLACSetup::seed, derived_seed, seed_size);
+#ifdef DEBUG_PPMLAC
+            std::cerr << "Bob stored setup seed" << std::endl;
+#endif
         }
         else {
             throw runtime_error("PPMLACPrep: Invalid player number, only 0 and 1 allowed");
@@ -128,47 +132,72 @@ public:
     // destruct global setup
     static void teardown()
     {
+#ifdef DEBUG_PPMLAC
         std::cerr << "Tearing down PPMLAC setup" << std::endl;
+#endif
     }
 
-    PPMLACPrep(SubProcessor<T>* proc, DataPositions& usage) :
-            BufferPrep<T>(usage), player(proc->P)
+    PPMLACPrep(SubProcessor<T>*, DataPositions& usage) :
+            BufferPrep<T>(usage), protocol(0)
     {
+#ifdef DEBUG_PPMLAC
         std::cerr << "PPMLACPrep constructor with SubProcessor" << std::endl;
+#endif
     }
 
-    PPMLACPrep(DataPositions& usage, Player& player) :
-            BufferPrep<T>(usage), player(player)
+    PPMLACPrep(DataPositions& usage, Player&) :
+            BufferPrep<T>(usage), protocol(0)
     {
+#ifdef DEBUG_PPMLAC
         std::cerr << "PPMLACPrep constructor with Player" << std::endl;
+#endif
     }
 
     // access to protocol instance if needed
-    void set_protocol(typename T::Protocol&)
+    void set_protocol(typename T::Protocol& protocol)
     {
+        this->protocol = &protocol;
+#ifdef DEBUG_PPMLAC
         std::cerr << "PPMLACPrep set_protocol called" << std::endl;
+#endif
     }
 
-    // buffer batch of multiplication triples in this->triples
+    // buffer batch of multiplication masks in this->triples
+    // Unlike Beaver triples, (r1, r2, q1) are the same uniformly random
+    // values at both parties. They only depend on the setup seed, so they
+    // can be produced ahead of time by PPMLAC-offline.x and read with -F.
     void buffer_triples()
     {
-        std::cerr << "PPMLACPrep buffer_triples called - not supported" << std::endl;
-        throw runtime_error("no triples");
+        CODE_LOCATION
+        auto& prng = get_prng();
+        int n = BaseMachine::batch_size<T>(DATA_TRIPLE);
+        size_t start = this->triples.size();
+        this->triples.resize(start + n);
+        for (auto it = this->triples.begin() + start;
+                it < this->triples.end(); it++)
+            for (auto& x : *it)
+                x.value.randomize(prng);
     }
 
     // buffer batch of random bit shares in this->bits
     void buffer_bits()
     {
         int n = 1000;
+#ifdef DEBUG_PPMLAC
         std::cerr << "Buffering " << n << " secure bits" << std::endl;
+#endif
         
+        // only party 0 holds the bit, otherwise the shares add up to 2 * bit
+        int my_num = protocol->P.my_num();
         for (int i = 0; i < n; i++) {
-            bool bit = PPMLACProtocol<T>::synchronized_prng.get_bit();
+            bool bit = get_prng().get_bit();
             typename T::clear value = bit ? 1 : 0;
-            this->bits.push_back(value);
+            this->bits.push_back(T::constant(value, my_num, {}));
         }
         
+#ifdef DEBUG_PPMLAC
         std::cerr << "Buffered " << n << " secure bits using synchronized PRNG" << std::endl;
+#endif
     }
 };
 
@@ -8,7 +8,10 @@
 #include "Protocols/MAC_Check_Base.h"
 #include "Processor/Input.h"
 #include "Tools/random.h"
-#include <map>
+#include "Tools/PointerVector.h"
+#include "Tools/CodeLocations.h"
+#include "Processor/BaseMachine.h"
+#include "Processor/TruncPrTuple.h"
 
 // opening facility
 template<class T>
@@ -31,7 +34,9 @@ public:
     {
         int other_party = 1 - P.my_num(); // Assuming two-party protocol
 
+#ifdef DEBUG_PPMLAC
         std::cerr << "OUTPUT EXCHANGE: P" << P.my_num() << " opening " << this->secrets.size() << " values with P" << other_party << std::endl;
+#endif
         octetStream os_send, os_receive;
 
         // Shares stored in this->secrets (inherited from MAC_Check_Base) are serialized 
@@ -51,7 +56,9 @@ public:
             other_share.unpack(os_receive);
             auto reconstructed = this->secrets[i].value + other_share.value;
             this->values.push_back(reconstructed);
+#ifdef DEBUG_PPMLAC
             std::cerr << "Reconstructed value: " << reconstructed<< " = " << this->secrets[i].value<< " (local) + " << other_share.value<< " (remote)" << std::endl;
+#endif
         }
 
         // Clear the shares after opening
@@ -59,18 +66,123 @@ public:
     }
 };
 
+// seed agreed on in PPMLACPrep::basic_setup(), shared by all domains and threads
+class PPMLACSetup
+{
+public:
+    static inline octet seed[SEED_SIZE] = {};
+
+    // independent stream for every domain, thread, and instance
+    static void derive(PRNG& G, const string& domain, int instance)
+    {
+        octetStream os;
+        os.append(seed, SEED_SIZE);
+        os.store(domain);
+        os.store(BaseMachine::thread_num);
+        os.store(instance);
+        G.SetSeed(os.hash().get_data());
+    }
+};
+
 // multiplication protocol
 template<class T>
 class PPMLACProtocol : public ProtocolBase<T>
 {
     // ProtocolBase: MP-SPDZ uses this base class to define a common interface for protocols that handle multiplications.
     // It provides methods for initializing, preparing, exchanging, and finalizing multiplications.
-    vector<T> x_vec, y_vec; // Buffers for input shares of multiplications
-    vector<T> results; // Buffer for output shares
-    octetStream os_send, os_receive; // Streams for sending and receiving data/ communication buffers
+    typedef typename T::clear clear;
+
+    // Operand shares x_0, y_0, x_1, y_1, ... of all scheduled terms.
+    // A multiplication is a dot product of length one, so both share
+    // the same buffers. ends[j] is one past the last term of output j.
+    vector<T> operands;
+    vector<size_t> ends;
+    vector<clear> masks, plain, q1; // Correlated masks for the current batch
+    vector<clear> row; // Scratch row for matrix products
+    IteratorVector<T> results; // Output shares, consumed by finalize_mul()
+    octetStream os; // Communication buffer, reused across rounds
+
+    // Masks come from the preprocessing as (r1, r2, q1) tuples,
+    // which are consumed as a flat stream.
+    Preprocessing<T>* prep;
+    array<T, 3> mask_tuple;
+    int mask_pos;
+
+    clear next_mask()
+    {
+        if (mask_pos == 3)
+        {
+            assert(prep);
+            prep->get_three(DATA_TRIPLE, mask_tuple[0], mask_tuple[1],
+                    mask_tuple[2]);
+            mask_pos = 0;
+        }
+        return mask_tuple[mask_pos++].value;
+    }
+
+    void get_masks(vector<clear>& res, size_t n)
+    {
+        res.resize(n);
+        for (auto& x : res)
+            x = next_mask();
+    }
+
+    // Alice sends her operand shares masked with r in one flat block,
+    // and Bob recovers [x]_1 + ([x]_0 - r) + r.
+    // Both parties hold the same masks, so they have to call this with
+    // the same number of operands.
+    void open_masked(const vector<T>& shares)
+    {
+        get_masks(masks, shares.size());
+        open_masked(shares, masks);
+    }
+
+    void open_masked(const vector<T>& shares, const vector<clear>& masks)
+    {
+        int other_party = 1 - P.my_num(); // Assuming two-party protocol
+        size_t n = shares.size();
+        size_t size = clear::size();
+        assert(masks.size() >= n);
+
+        if(P.my_num() == 0) // Alice
+        {
+            os.reset_write_head();
+            os.reserve(n * size);
+            for(size_t i = 0; i < n; i++)
+            {
+                clear d = shares[i].value - masks[i];
+                os.append_no_resize((octet*) d.get_ptr(), size);
+            }
+            P.send_to(other_party, os); // Send packed data to Bob
+        }
+        else if(P.my_num() == 1) // Bob
+        {
+            // Receive masked values from Alice without intermediate copy
+            plain.resize(n);
+            P.receive_player(other_party, plain);
+            for(size_t i = 0; i < n; i++)
+                plain[i] += shares[i].value + masks[i];
+        }
+        else{
+            throw runtime_error("PPMLACPrep: Invalid player number, only 2 allowed");
+        }
+    }
+
+    // Alice's output share is q1, Bob's is the product minus q1
+    T output_share(const clear& product, const clear& q)
+    {
+        if (P.my_num() == 0)
+            return q;
+        else
+            return T(product - q);
+    }
+
 public:
-    static PRNG synchronized_prng;  // Static synchronized PRNG
-    static PRNG local_prng;
+    // Protocol instances are created in the same order by both parties,
+    // so counting them per thread keeps the streams in sync.
+    static thread_local int n_instances;
+
+    PRNG synchronized_prng; // Same at both parties
     Player& P;
     static int get_n_relevant_players() 
     {
@@ -79,10 +191,15 @@ public:
         return 2;
     }
 
-    PPMLACProtocol(Player& P) :P(P){
-        octet seed[SEED_SIZE];
-        synchronized_prng.get_octets(seed, SEED_SIZE);
-        local_prng.SetSeed(seed);
+    PPMLACProtocol(Player& P) : prep(0), mask_pos(3), P(P){
+        PPMLACSetup::derive(synchronized_prng, T::type_short(), n_instances++);
+        results.reset();
+    }
+
+    // masks are read from the live or file-based preprocessing
+    void init(Preprocessing<T>& prep, typename T::MAC_Check&)
+    {
+        this->prep = &prep;
     }
 
     // prepare next round of multiplications
@@ -90,213 +207,316 @@ public:
     {
         // Initialize the multiplication protocol by clearing buffers
         // Called once per round of multiplications
-        x_vec.clear();
-        y_vec.clear();
+        // clear() keeps the capacity, so steady-state rounds do not allocate
+        if (results.left())
+            throw runtime_error("unused data in PPMLAC");
+        operands.clear();
+        ends.clear();
         results.clear();
-        os_send.clear();
-        os_receive.clear();
     }
 
     // schedule multiplication
     void prepare_mul(const T&x, const T&y, int = -1)
     {
-        x_vec.push_back(x); // Store the first operand
-        y_vec.push_back(y); // Store the second operand
+        prepare_dotprod(x, y);
+        next_dotprod();
     }
 
     // execute protocol
     // Core function that handles the multiplication protocol.
+    // Alice sends d = [x]_0 - r1 and e = [y]_0 - r2 and keeps [z]_0 = q1.
+    // A product consumes one mask tuple, a dot product of length l
+    // consumes 2l + 1 masks, i.e., at most l tuples.
+    // Bob computes [z]_1 = sum ([x]_1 + d + r1) * ([y]_1 + e + r2) - q1,
+    // so a dot product only costs one output mask.
     void exchange()
     {
-        int other_party = 1 - P.my_num(); // Assuming two-party protocol
-        if(P.my_num() == 0) // Alice
+        CODE_LOCATION
+        open_masked(operands);
+        get_masks(q1, ends.size());
+        this->rounds++;
+
+        results.resize(ends.size());
+        size_t term = 0;
+        for (size_t j = 0; j < ends.size(); j++)
         {
-            // Alice's side: send her inputs to Bob
-            for(size_t i = 0; i < x_vec.size(); i++)
-            {
-                // Generate random mask
-                auto r1 = synchronized_prng.get<typename T::clear>();
-                auto r2 = synchronized_prng.get<typename T::clear>();
-                auto q1 = synchronized_prng.get<typename T::clear>(); // samples a fresh q1
+            clear product;
+            if (P.my_num() == 1)
+                for (; term < ends[j]; term++)
+                    product += plain[2 * term] * plain[2 * term + 1];
+            results[j] = output_share(product, q1[j]);
+#ifdef DEBUG_PPMLAC
+            std::cerr << "P" << P.my_num() << ": product=" << product
+                    << " q1=" << q1[j] << " result_share=" << results[j]
+                    << std::endl;
+#endif
+        }
 
+        results.reset();
+    }
 
-                std::cerr << "ALICE: x_share=" << x_vec[i]<< " y_share=" << y_vec[i]<< " r1=" << r1 << " r2=" << r2 << " q1=" << q1 << std::endl;
+    // return next product
+    T finalize_mul(int n = -1)
+    {
+        this->add_mul(n);
+        return results.next();
+    }
 
-                // Compute masked values d,e
-                auto d = x_vec[i] - r1;
-                auto e = y_vec[i] - r2;
+    void init_dotprod()
+    {
+        init_mul();
+    }
 
-                // Pack for sending
-                d.pack(os_send); // Pack the first operand
-                e.pack(os_send); // Pack the second operand
+    void prepare_dotprod(const T& x, const T& y)
+    {
+        operands.push_back(x); // Store the first operand
+        operands.push_back(y); // Store the second operand
+    }
 
-                results.push_back(T(q1)); // sets her output share [z]_0 = q1.
+    void next_dotprod()
+    {
+        ends.push_back(operands.size() / 2);
+    }
+
+    T finalize_dotprod(int length)
+    {
+        this->counter += length;
+        this->dot_counter++;
+        return results.next();
+    }
+
+    // Mask every matrix entry once instead of once per inner product term,
+    // which brings the communication down to O(mk + kn) per product.
+    void matmulsm(SubProcessor<T>& processor, MemoryPart<T>& source,
+            const Instruction& instruction)
+    {
+        CODE_LOCATION
+        auto& args = instruction.get_start();
+        auto& S = processor.get_S();
+        auto Proc = processor.Proc;
+        assert(Proc);
+
+        // collect the entries of all factors for a single round
+        operands.clear();
+        for (auto matmulArgs = args.begin(); matmulArgs < args.end();
+                matmulArgs += 12)
+        {
+            size_t firstFactorBase  = Proc->get_Ci().at(matmulArgs[1]).get();
+            size_t secondFactorBase = Proc->get_Ci().at(matmulArgs[2]).get();
+            auto resultNumberOfRows = matmulArgs[3];
+            auto usedNumberOfFirstFactorColumns = matmulArgs[4];
+            auto resultNumberOfColumns = matmulArgs[5];
+            auto firstFactorTotalNumberOfColumns = matmulArgs[10];
+            auto secondFactorTotalNumberOfColumns = matmulArgs[11];
+
+            for (int i = 0; i < resultNumberOfRows; i++)
+            {
+                auto actualFirstFactorRow = Proc->get_Ci().at(matmulArgs[6] + i).get();
+                for (int k = 0; k < usedNumberOfFirstFactorColumns; k++)
+                {
+                    auto actualFirstFactorColumn = Proc->get_Ci().at(matmulArgs[7] + k).get();
+                    operands.push_back(source.at(firstFactorBase
+                            + actualFirstFactorRow * firstFactorTotalNumberOfColumns
+                            + actualFirstFactorColumn));
+                }
+            }
+
+            for (int k = 0; k < usedNumberOfFirstFactorColumns; k++)
+            {
+                auto actualSecondFactorRow = Proc->get_Ci().at(matmulArgs[8] + k).get();
+                for (int j = 0; j < resultNumberOfColumns; j++)
+                {
+                    auto actualSecondFactorColumn = Proc->get_Ci().at(matmulArgs[9] + j).get();
+                    operands.push_back(source.at(secondFactorBase
+                            + actualSecondFactorRow * secondFactorTotalNumberOfColumns
+                            + actualSecondFactorColumn));
+                }
             }
-            P.send_to(other_party, os_send); // Send packed data to Bob
         }
-        else if(P.my_num() == 1) // Bob
+
+        open_masked(operands);
+        this->rounds++;
+
+        auto& row = this->row;
+        auto entry = plain.begin();
+        for (auto matmulArgs = args.begin(); matmulArgs < args.end();
+                matmulArgs += 12)
         {
-            // Bob's side: receive Alice's inputs and perform multiplications
-            P.receive_player(other_party, os_receive); // Receive masked value d,e from Alice
+            auto C = S.begin() + matmulArgs[0];
+            int m = matmulArgs[3], l = matmulArgs[4], n = matmulArgs[5];
+            assert(C + m * n <= S.end());
 
-            for(size_t i = 0; i < x_vec.size(); i++)
+            for (int i = 0; i < m; i++)
             {
-                // r1,r2 is the same as Alice's r1,r2 due to synchronized PRNG
-                auto r1 = synchronized_prng.get<typename T::clear>();
-                auto r2 = synchronized_prng.get<typename T::clear>();
-                auto q1 = synchronized_prng.get<typename T::clear>(); // Same q1 as Alice's
-
-                T d,e;
-                d.unpack(os_receive); // Unpack the first operand
-                e.unpack(os_receive); // Unpack the second operand
-
-                auto u = x_vec[i] +d;
-                auto v = y_vec[i] + e;
-                auto product = (u.value + r1)*(v.value + r2);
-                auto result_share = product - q1;
-
-                std::cerr << "BOB: x_share=" << x_vec[i]<< " y_share=" << y_vec[i]<< " r1=" << r1 << " r2=" << r2 << " q1=" << q1 << std::endl;
-                std::cerr << "  d=" << d << " e=" << e<< " u=" << u << " v=" << v << std::endl;
-                std::cerr << "  product=" << product<< " result_share=" << result_share << std::endl;
-                
-                // Compute [z]_1 = (u + r1) * (v + r2) - q1 = x * y - q1
-                // z[0] + z[1] = x*y
-                results.push_back(T(result_share));
+                row.assign(n, {});
+                if (P.my_num() == 1)
+                {
+                    auto A = entry + i * l;
+                    auto B = entry + m * l;
+                    for (int k = 0; k < l; k++)
+                        for (int j = 0; j < n; j++)
+                            row[j] += A[k] * B[k * n + j];
+                }
+                for (int j = 0; j < n; j++)
+                    *(C + i * n + j) = output_share(row[j], next_mask());
             }
-        }
-        else{
-            throw runtime_error("PPMLACPrep: Invalid player number, only 2 allowed");
+
+            if (P.my_num() == 1)
+                entry += m * l + l * n;
+            this->counter += m * l * n;
+            this->dot_counter += m * n;
         }
     }
 
-    // return next product
-    T finalize_mul(int = -1)
+    template<int = 0>
+    void trunc_pr(const vector<int>&, int, SubProcessor<T>&, true_type)
     {
-        T res = results.front();
-        results.erase(results.begin()); // Remove the first result from the buffer
-        return res; // Return the first result
+        throw not_implemented();
+    }
+
+    // Bob recovers the inputs like in a multiplication, so he can
+    // truncate exactly, and the result is reshared with fresh masks.
+    // All truncations of an instruction take a single round and
+    // there are no constraints on the gap.
+    // The compiler does not expect truncation to use preprocessing,
+    // so the masks come from the synchronized PRNG.
+    template<int = 0>
+    void trunc_pr(const vector<int>& regs, int size, SubProcessor<T>& proc,
+            false_type)
+    {
+        CODE_LOCATION
+        assert(regs.size() % 4 == 0);
+        TruncPrTupleList<T> infos(regs, proc.get_S(), size);
+
+        operands.clear();
+        for (auto info : infos)
+        {
+            for (auto& x : info.source_range)
+                operands.push_back(x);
+            if (info.big_gap())
+                this->trunc_pr_big_counter += size;
+            else
+                this->trunc_pr_counter += size;
+        }
+
+        masks.resize(operands.size());
+        for (auto& mask : masks)
+            mask.randomize(synchronized_prng);
+        open_masked(operands, masks);
+        this->trunc_rounds++;
+
+        auto x = plain.begin();
+        for (auto info : infos)
+            for (auto& y : info.dest_range)
+            {
+                clear res, q;
+                q.randomize(synchronized_prng);
+                // shift a non-negative value for rounding down,
+                // logically because the sum uses all bits if k == K
+                if (P.my_num() == 1)
+                    res = clear(Z2<clear::N_BITS>(*x++ + info.add_before())
+                            >> info.m) - info.subtract_after();
+                y = output_share(res, q);
+            }
     }
+
+    int get_buffer_size() { return operands.size() / 2; }
 };
 
 // Definition provides actual storage
-template<class T> PRNG PPMLACProtocol<T>::synchronized_prng;
-template<class T> PRNG PPMLACProtocol<T>::local_prng;  // Add this line
+template<class T> thread_local int PPMLACProtocol<T>::n_instances = 0;
 
+// private input facility
+// The input owner keeps a random mask r as its share and sends input - r.
 template<class T>
 class PPMLACInput : public InputBase<T>
 {
-private:
+    typedef typename T::open_type open_type;
+
     Player& P;
     int my_num;
     int other_player;
 
-    // Store local input shares and masked values, per player
-    std::map<int, std::vector<T>> my_shares;
-    std::map<int, std::vector<typename T::open_type>> masked_values;
-    std::map<int, octetStream> buffered_input_streams;
+    // my scheduled inputs and the resulting shares
+    vector<open_type> my_inputs;
+    PointerVector<T> my_shares;
+    // number of inputs expected from each player
+    vector<size_t> n_expected;
+
+    SeededPRNG local_prng; // Only known to this party
 
 public:
     PPMLACInput(SubProcessor<T>& proc, typename T::MAC_Check&) :
-        P(proc.P), my_num(P.my_num()), other_player(1 - my_num)
+        InputBase<T>(&proc), P(proc.P), my_num(P.my_num()),
+        other_player(1 - my_num), n_expected(P.num_players())
     {
         if (P.num_players() != 2){
             throw std::runtime_error("PPMLACInput supports only 2 players");
         }
-        std::cerr << "INPUT_INIT: Player " << my_num << std::endl;
+        this->reset_all(P);
     }
 
     void reset(int player)
     {
-        my_shares[player].clear();
-        masked_values[player].clear();
-        //std::cerr << "Reset input buffer for player " << player << std::endl;
+        InputBase<T>::reset(player);
+        if (player == my_num)
+        {
+            my_inputs.clear();
+            my_shares.clear();
+        }
+        n_expected.at(player) = 0;
     }
 
-    void add_mine(const typename T::open_type& input, int = -1)
+    void add_mine(const open_type& input, int = -1)
     {
-        typename T::clear r;
-        r.randomize(PPMLACProtocol<T>::local_prng);
-
-        T share(r);
-        my_shares[my_num].push_back(share);
-        masked_values[my_num].push_back(input - r);
-
-        std::cerr << "Added private input (player " << my_num << ")" << std::endl;
+        my_inputs.push_back(input);
+        this->values_input++;
     }
 
     void add_other(int player, int = -1)
     {
         if (player == my_num)
             throw std::runtime_error("Should not add_other for self");
-        std::cerr << "Expecting input from player " << player << std::endl;
+        n_expected.at(player)++;
     }
 
+    // generate all masks at once and serialize the masked inputs as one block
     void send_mine()
     {
-        if (masked_values[my_num].empty()){
-            std::cerr << "WARNING: send_mine called with empty buffer" << std::endl;
-            return;
-        }
-            
-        octetStream os;
-        for (const auto& val : masked_values[my_num]){
-            val.pack(os);
-        }
-        std::cerr << "Sending " << masked_values[my_num].size() << " values to P" << other_player << std::endl;
-        P.send_to(other_player, os);
+        size_t n = my_inputs.size();
+        size_t size = open_type::size();
+        auto& os = this->os[my_num];
+
+        my_shares.resize(n);
+        for (auto& share : my_shares)
+            share.value.randomize(local_prng);
 
+        os.reserve(n * size);
+        for (size_t i = 0; i < n; i++)
+        {
+            open_type masked = my_inputs[i] - my_shares[i].value;
+            os.append_no_resize((octet*) masked.get_ptr(), size);
+        }
     }
 
+    // both parties send and receive simultaneously, even if empty
     void exchange() override
     {
-        //std::cerr << "Input exchange (P" << my_num << "): ";
-        
-        if (my_num == 0) {  // Party 0: send then receive
-            //std::cerr << "Send->Receive" << std::endl;
-            if (!masked_values[my_num].empty()) {
-                send_mine();
-            }
-            octetStream os;
-            P.receive_player(other_player, os);
-            buffered_input_streams[other_player] = std::move(os);
-        }
-        else {  // Party 1: receive then send
-            //std::cerr << "Receive->Send" << std::endl;
-            octetStream os;
-            P.receive_player(other_player, os);
-            buffered_input_streams[other_player] = std::move(os);
-            
-            if (!masked_values[my_num].empty()) {
-                send_mine();
-            }
-        }
+        CODE_LOCATION
+        send_mine();
+        auto& os = this->os[other_player];
+        P.exchange(other_player, this->os[my_num], os);
+        if (os.left() < n_expected[other_player] * open_type::size())
+            throw runtime_error("insufficient input data received in PPMLAC");
     }
 
     T finalize_mine()
     {
-        if (my_shares[my_num].empty()){
-            throw std::runtime_error("No shares to finalize for mine");
-        } 
-        T result = my_shares[my_num].front();
-        my_shares[my_num].erase(my_shares[my_num].begin());
-
-        return result;
+        return my_shares.next();
     }
 
-    void finalize_other(int player, T& target, octetStream&, int = -1)
+    void finalize_other(int, T& target, octetStream& os, int = -1)
     {
-        if (buffered_input_streams[player].get_length() == 0 || buffered_input_streams.find(player) == buffered_input_streams.end())
-        {
-            std::cerr << "Error: No data in buffered_input_streams for player " << player << std::endl;
-            throw std::runtime_error("INPUTMIXED: insufficient data");
-        }
-
-        typename T::open_type masked_value;
-        masked_value.unpack(buffered_input_streams[player]);
-        target = T(masked_value);
-
-        std::cerr << "Received input from P" << player << std::endl;
+        target.value.assign(os.consume_no_check(open_type::size()));
     }
-
 };
-
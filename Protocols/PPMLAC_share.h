@@ -7,6 +7,7 @@
 #include "ShareInterface.h"
 #include "Math/bigint.h"
 #include "Math/gfp.h"
+#include "Math/Z2k.h"
 #include "GC/NoShare.h"
 #include "BMR/Register.h"
 
@@ -49,6 +50,9 @@ public:
     static const bool dishonest_majority = true;
     static const bool variable_players = true;
 
+    // native probabilistic truncation, see PPMLACProtocol::trunc_pr()
+    static const bool has_trunc_pr = true;
+
     // Default constructor
     PPMLACShare() = default;
 
@@ -62,9 +66,11 @@ public:
     }
 
     // used for preprocessing storage location
+    // must differ between domains because the directory only depends
+    // on the bit length
     static string type_short()
     {
-        return "P";
+        return "P" + string(1, clear::type_char());
     }
 
     // size in bytes
@@ -178,3 +184,6 @@ inline ostream& operator<<(ostream& o, const PPMLACShare<T>& share)
     return o;
 }
 
+// computation modulo 2^K for RingMachine, signed like the other ring protocols
+template<int K>
+using PPMLACRingShare = PPMLACShare<SignedZ2<K>>;
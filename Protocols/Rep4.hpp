@@ -299,10 +299,14 @@ template<class T>
 void Rep4<T>::must_check()
 {
     CODE_LOCATION
-    octetStreams to_send(P);
+    array<array<octetStream, 4>, 4> hashes;
+    vector<vector<const octetStream*>> to_send(P.num_players());
     for (int i = 1; i < 4; i++)
         for (int j = 0; j < 4; j++)
-            to_send[P.get_player(i)].concat(send_hashes[j][P.get_player(i)].final());
+        {
+            hashes[i][j] = send_hashes[j][P.get_player(i)].final();
+            to_send[P.get_player(i)].push_back(&hashes[i][j]);
+        }
 
     octetStreams to_receive;
     P.send_receive_all(to_send, to_receive);
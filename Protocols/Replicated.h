@@ -184,6 +184,9 @@ class Replicated : public ReplicatedBase, public ProtocolBase<T>
 
     bool fast_mode;
 
+    // sending between start_exchange() and stop_exchange()
+    CommRequest send_request;
+
     void prepare_exchange();
     void check_received();
 
@@ -288,7 +288,7 @@ void Replicated<T>::start_exchange()
 {
     prepare_exchange();
     os[0].append(0);
-    P.send_relative(1, os[0]);
+    send_request = P.isend(P.get_player(1), os[0]);
     this->rounds++;
 }
 
@@ -296,6 +296,7 @@ template<class T>
 void Replicated<T>::stop_exchange()
 {
     P.receive_relative(-1, os[1]);
+    send_request.wait();
     check_received();
 }
 
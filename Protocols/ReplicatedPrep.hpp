@@ -14,6 +14,7 @@
 #include "Spdz2kPrep.h"
 #include "GC/BitAdder.h"
 #include "Processor/OnlineOptions.h"
+#include "Tools/Trace.h"
 #include "Protocols/Rep3Share.h"
 
 #include "MaliciousRingPrep.hpp"
@@ -232,6 +233,7 @@ void BufferPrep<T>::get_three_no_count(Dtype dtype, T& a, T& b, T& c)
         if (OnlineOptions::singleton.has_option("verbose_triples"))
             fprintf(stderr, "out of %s triples\n", T::type_string().c_str());
         InScope in_scope(this->do_count, false, *this);
+        TraceScope trace("buffer triples", "prep");
         buffer_triples();
         assert(not triples.empty());
     }
@@ -336,6 +338,7 @@ void BufferPrep<T>::get_two_no_count(Dtype dtype, T& a, T& b)
         if (squares.empty())
         {
             InScope in_scope(this->do_count, false, *this);
+            TraceScope trace("buffer squares", "prep");
             buffer_squares();
         }
 
@@ -349,6 +352,7 @@ void BufferPrep<T>::get_two_no_count(Dtype dtype, T& a, T& b)
         while (inverses.empty())
         {
             InScope in_scope(this->do_count, false, *this);
+            TraceScope trace("buffer inverses", "prep");
             buffer_inverses();
         }
 
@@ -1209,6 +1213,7 @@ void BufferPrep<T>::get_one_no_count(Dtype dtype, T& a)
     while (bits.empty())
     {
         InScope in_scope(this->do_count, false, *this);
+        TraceScope trace("buffer bits", "prep");
         buffer_bits();
         n_bit_rounds++;
     }
@@ -1226,6 +1231,7 @@ void BufferPrep<T>::get_input_no_count(T& a, typename T::open_type& x, int i)
     if (inputs.at(i).empty())
     {
         InScope in_scope(this->do_count, false, *this);
+        TraceScope trace("buffer inputs", "prep", i);
         buffer_inputs(i);
         assert(not inputs.empty());
     }
@@ -1240,6 +1246,7 @@ void BufferPrep<T>::get_dabit_no_count(T& a, typename T::bit_type& b)
     if (dabits.empty())
     {
         InScope in_scope(this->do_count, false, *this);
+        TraceScope trace("buffer dabits", "prep");
         ThreadQueues* queues = 0;
         buffer_dabits(queues);
         assert(not dabits.empty());
@@ -1256,6 +1263,7 @@ void BufferPrep<T>::get_personal_dabit(int player, T& a, typename T::bit_type& b
     if (buffer.empty())
     {
         InScope in_scope(this->do_count, false, *this);
+        TraceScope trace("buffer personal dabits", "prep", player);
         buffer_personal_dabits(player);
     }
     a = buffer.back().first;
@@ -1277,6 +1285,7 @@ edabitvec<T> BufferPrep<T>::get_edabitvec(bool strict, int n_bits)
     if (buffer.empty())
     {
         InScope in_scope(this->do_count, false, *this);
+        TraceScope trace("buffer edabits", "prep");
         buffer_edabits_with_queues(strict, n_bits);
     }
     assert(not buffer.empty());
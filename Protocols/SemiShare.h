@@ -106,6 +106,15 @@ public:
             return {};
     }
 
+    // scaling the additive share scales the secret
+    template<class U, class V>
+    static void mul_batch(U* z, const U* x, const V* y, size_t n,
+            int z_step = 1, int x_step = 1, int y_step = 1)
+    {
+        static_assert(sizeof(U) == sizeof(T), "share differs from value");
+        T::mul_batch(z, x, y, n, z_step, x_step, y_step);
+    }
+
     SemiShare()
     {
     }
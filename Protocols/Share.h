@@ -82,6 +82,29 @@ class Share_ : public ShareInterface
    static Share_ constant(const open_type& aa, int my_num, const typename V::Scalar& alphai)
      { return Share_(aa, my_num, alphai); }
 
+   // share and MAC separately if they are of the same kind
+   template<class U, class W>
+   static void mul_batch(U* z, const U* x, const W* y, size_t n,
+           int z_step = 1, int x_step = 1, int y_step = 1)
+   {
+     mul_batch(z, x, y, n, z_step, x_step, y_step,
+         integral_constant<bool, is_same<T, V>::value and
+             is_same<W, clear>::value and sizeof(U) == 2 * sizeof(T)>());
+   }
+   template<class U, class W>
+   static void mul_batch(U* z, const U* x, const W* y, size_t n,
+           int z_step, int x_step, int y_step, true_type)
+   {
+     T::mul_batch(&z->a, &x->a, y, n, 2 * z_step, 2 * x_step, y_step);
+     T::mul_batch(&z->mac, &x->mac, y, n, 2 * z_step, 2 * x_step, y_step);
+   }
+   template<class U, class W>
+   static void mul_batch(U* z, const U* x, const W* y, size_t n,
+           int z_step, int x_step, int y_step, false_type)
+   {
+     ShareInterface::mul_batch(z, x, y, n, z_step, x_step, y_step);
+   }
+
    template<class U, class W>
    void assign(const Share_<U, W>& S)
      { a=S.get_share(); mac=S.get_mac(); }
@@ -77,6 +77,16 @@ public:
 
     static bool get_rec_factor(int, int) { return false; }
 
+    // elementwise multiplication by public values, element i at
+    // z[i * z_step] etc.
+    template<class T, class U>
+    static void mul_batch(T* z, const T* x, const U* y, size_t n,
+            int z_step = 1, int x_step = 1, int y_step = 1)
+    {
+        for (size_t i = 0; i < n; i++)
+            z[i * z_step] = x[i * x_step] * y[i * y_step];
+    }
+
     template<class T>
     static void read_or_generate_mac_key(const string&, const Player&, T&) {}
 
@@ -273,6 +273,8 @@ public:
     typedef ValueMatrix<typename T::open_type> open_type;
     typedef typename T::mac_key_type mac_key_type;
 
+    using ShareInterface::mul_batch;
+
     static string type_string()
     {
         return "matrix";
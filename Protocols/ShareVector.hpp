@@ -18,7 +18,9 @@ void ShareVector<U>::fft(const FFT_Data& fftd)
 
     for (auto& x : data)
     {
-        if (fftd.get_twop() == 0)
+        if (fftd.get_ntt(0).active() and fftd.get_twop() == 0)
+            fftd.get_ntt(0).apply(x);
+        else if (fftd.get_twop() == 0)
             FFT_Iter2(x, fftd.phi_m(), fftd.get_root(0), fftd.get_prD());
         else
             FFT_non_power_of_two(x, x, fftd);
@@ -0,0 +1,51 @@
+#!/usr/bin/env bash
+
+# Compare switch and threaded instruction dispatch (THREADED_DISPATCH in
+# CONFIG) by running programs in the emulator built both ways.
+#
+# usage: Scripts/bench-dispatch.sh [-r <repetitions>] [program...]
+#
+# The programs are compiled for 64-bit rings and have to run in the
+# emulator, i.e., without input from other parties. The default are
+# the tutorials that satisfy this. emulate.x is left in the default
+# configuration.
+
+reps=3
+
+while getopts r: opt; do
+    case $opt in
+	r) reps=$OPTARG
+	   ;;
+    esac
+done
+
+shift $[OPTIND-1]
+
+progs=${*:-oram_tutorial gale-shapley_tutorial}
+
+function build
+{
+    # the flag only affects the instantiation in the machine
+    rm -f Machines/emulate.o emulate.x
+    make -j$(nproc) THREADED_DISPATCH=$1 emulate.x > /dev/null || exit 1
+    cp emulate.x emulate-dispatch-$1.x
+}
+
+build 1
+build 0
+
+for prog in $progs; do
+    ./compile.py -R 64 $prog > /dev/null || exit 1
+done
+
+for prog in $progs; do
+    for mode in 0 1; do
+	test $mode = 1 && name=threaded || name=switch
+	for i in $(seq $reps); do
+	    ./emulate-dispatch-$mode.x $prog 2>&1 |
+		grep '^Time =' | sed "s/^/$prog $name: /"
+	done
+    done
+done
+
+rm -f emulate-dispatch-*.x
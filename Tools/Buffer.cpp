@@ -7,11 +7,18 @@
 #include "Processor/BaseMachine.h"
 
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 
 bool BufferBase::rewind = false;
 
+// distance to read ahead of the current position
+#ifndef BUFFER_PREFETCH
+#define BUFFER_PREFETCH (1 << 24)
+#endif
+
 
 void BufferBase::setup(ifstream* f, int length, const string& filename,
         const char* type, const string& field)
@@ -23,6 +30,98 @@ void BufferBase::setup(ifstream* f, int length, const string& filename,
     this->filename = filename;
 }
 
+void BufferBase::start_reading()
+{
+    file = open();
+    map();
+}
+
+bool BufferBase::start_mapped()
+{
+    if (not file)
+        start_reading();
+    return mapped;
+}
+
+void BufferBase::map()
+{
+    // variable-length elements are read through the stream
+    if (mapped or not file or not file->good() or element_length() <= 0
+            or is_pipe() or OnlineOptions::singleton.has_option("no_mmap"))
+        return;
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat buf;
+    if (fstat(fd, &buf) == 0 and buf.st_size > 0)
+    {
+        void* res = mmap(0, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (res != MAP_FAILED)
+        {
+            mapped = (char*) res;
+            mapped_size = buf.st_size;
+            mapped_pos = file->tellg();
+            prefetched = mapped_pos;
+            madvise(mapped, mapped_size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+            if (OnlineOptions::singleton.has_option("huge_pages"))
+                madvise(mapped, mapped_size, MADV_HUGEPAGE);
+#endif
+            prefetch();
+        }
+    }
+
+    close(fd);
+}
+
+void BufferBase::unmap()
+{
+    if (mapped)
+        munmap(mapped, mapped_size);
+    mapped = 0;
+    mapped_size = 0;
+}
+
+void BufferBase::prefetch()
+{
+    // keep a window ahead of the current position in flight
+    if (prefetched >= min(mapped_pos + BUFFER_PREFETCH / 2, mapped_size))
+        return;
+
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t start = max(prefetched, mapped_pos) / page_size * page_size;
+    size_t end = min(mapped_pos + BUFFER_PREFETCH, mapped_size);
+    madvise(mapped + start, end - start, MADV_WILLNEED);
+    prefetched = end;
+}
+
+void BufferBase::read_mapped(char* buffer, size_t length)
+{
+    size_t done = 0;
+    while (done < length)
+    {
+        if (mapped_pos >= mapped_size)
+            try_rewind();
+        size_t n = min(length - done, mapped_size - mapped_pos);
+        memcpy(buffer + done, mapped + mapped_pos, n);
+        mapped_pos += n;
+        done += n;
+    }
+    prefetch();
+}
+
+const char* BufferBase::get_mapped(size_t length)
+{
+    if (mapped_pos + length > mapped_size)
+        try_rewind();
+    auto res = mapped + mapped_pos;
+    mapped_pos += length;
+    prefetch();
+    return res;
+}
+
 bool BufferBase::is_pipe()
 {
     struct stat buf;
@@ -45,7 +144,17 @@ void BufferBase::seekg(int pos)
         if (pos == 0)
             return;
         else
-            file = open();
+            start_reading();
+    }
+
+    if (mapped)
+    {
+        // running out is handled when reading
+        mapped_pos = header_length + size_t(pos) * tuple_length;
+        prefetched = mapped_pos;
+        prefetch();
+        next = BUFFER_SIZE;
+        return;
     }
 
     file->seekg(header_length + pos * tuple_length);
@@ -73,10 +182,20 @@ void BufferBase::try_rewind()
         type = (string)" of " + field_type + " " + data_type;
     throw not_enough_to_buffer(type, filename);
 #endif
-    file->clear(); // unset EOF flag
-    file->seekg(header_length);
-    if (file->peek() == ifstream::traits_type::eof())
-        throw runtime_error("empty file: " + filename);
+    if (mapped)
+    {
+        mapped_pos = header_length;
+        prefetched = mapped_pos;
+        if (mapped_pos >= mapped_size)
+            throw runtime_error("empty file: " + filename);
+    }
+    else
+    {
+        file->clear(); // unset EOF flag
+        file->seekg(header_length);
+        if (file->peek() == ifstream::traits_type::eof())
+            throw runtime_error("empty file: " + filename);
+    }
     if (!rewind)
         cerr << "REUSING DATA - ONLY FOR BENCHMARKING" << endl;
     rewind = true;
@@ -93,6 +212,13 @@ void BufferBase::prune()
     if (is_pipe())
         return;
 
+    // the stream is not used for reading if mapped
+    if (mapped)
+    {
+        file->seekg(mapped_pos);
+        unmap();
+    }
+
     if (file and (not file->good() or file->peek() == EOF))
         purge();
     else if (file and file->tellg() != header_length)
@@ -140,6 +266,7 @@ void BufferBase::purge()
     {
         if (verbose)
             cerr << "Removing " << filename << endl;
+        unmap();
         unlink(filename.c_str());
         if (file)
         {
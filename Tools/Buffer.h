@@ -35,14 +35,27 @@ protected:
     string filename;
     int header_length;
 
+    // regular files are mapped in full to avoid copying through ifstream
+    char* mapped;
+    size_t mapped_size, mapped_pos, prefetched;
+
     virtual int element_length() = 0;
 
+    void start_reading();
+    bool start_mapped();
+    void map();
+    void unmap();
+    void prefetch();
+    void read_mapped(char* buffer, size_t length);
+    const char* get_mapped(size_t length);
+
 public:
     bool eof;
 
     BufferBase() : file(0), next(BUFFER_SIZE),
-            tuple_length(-1), header_length(0), eof(false) {}
-    ~BufferBase() {}
+            tuple_length(-1), header_length(0), mapped(0), mapped_size(0),
+            mapped_pos(0), prefetched(0), eof(false) {}
+    ~BufferBase() { unmap(); }
     virtual ifstream* open() = 0;
     void setup(ifstream* f, int length, const string& filename,
             const char* type = "", const string& field = {});
@@ -69,6 +82,7 @@ public:
     virtual ~Buffer();
     virtual ifstream* open();
     void input(U& a);
+    void input(U* a, size_t n);
     void fill_buffer();
 };
 
@@ -201,6 +215,14 @@ inline void Buffer<T, U>::fill_buffer()
       // read directly
       read((char*)buffer);
     }
+  else if (start_mapped())
+    {
+      // no intermediate copy
+      timer.start();
+      for (int i = 0; i < BUFFER_SIZE; i++)
+        buffer[i].assign(get_mapped(T::size()));
+      timer.stop();
+    }
   else
     {
       char* read_buffer = new char[BUFFER_SIZE * T::size()];
@@ -224,8 +246,12 @@ inline void Buffer<T, U>::read(char* read_buffer)
     int size_in_bytes = T::size() * BUFFER_SIZE;
     int n_read = 0;
     timer.start();
-    if (not file)
-        file = open();
+    if (start_mapped())
+    {
+        read_mapped(read_buffer, size_in_bytes);
+        timer.stop();
+        return;
+    }
     do
     {
         file->read(read_buffer + n_read, size_in_bytes - n_read);
@@ -267,4 +293,27 @@ inline void Buffer<T,U>::input(U& a)
     next++;
 }
 
+template <class T, class U>
+inline void Buffer<T,U>::input(U* a, size_t n)
+{
+    size_t i = 0;
+
+    // use up buffered tuples first to keep the order
+    for (; i < n and next < BUFFER_SIZE; i++)
+        input(a[i]);
+
+    // then copy straight from the mapping
+    if (is_same<T, U>::value and T::size() == sizeof(T) and i < n
+            and start_mapped())
+    {
+        timer.start();
+        read_mapped((char*) (a + i), (n - i) * sizeof(T));
+        timer.stop();
+        i = n;
+    }
+
+    for (; i < n; i++)
+        input(a[i]);
+}
+
 #endif /* TOOLS_BUFFER_H_ */
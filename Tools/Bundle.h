@@ -39,6 +39,13 @@ public:
                 throw mismatch_among_parties();
     }
 
+    // only exchange hashes of large content
+    void compare_hash(PlayerBase& P)
+    {
+        mine = mine.hash();
+        compare(P);
+    }
+
     void reset()
     {
         for (auto& x : *this)
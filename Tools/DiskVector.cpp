@@ -5,8 +5,11 @@
 
 #include "DiskVector.h"
 #include "Processor/OnlineOptions.h"
+#include "Tools/int.h"
 
 #include <fstream>
+#include <iostream>
+#include <sys/mman.h>
 
 void sigbus_handler(int)
 {
@@ -45,4 +48,82 @@ void DiskVectorBase::init(size_t byte_size)
     boost::filesystem::remove(path);
 
     signal(SIGBUS, sigbus_handler);
+
+    size_t max_bytes = size_t(OnlineOptions::singleton.disk_memory_cache) << 20;
+    if (max_bytes)
+        cache = new DiskCache(file.data(), byte_size, max_bytes);
+}
+
+DiskCache::DiskCache(char* data, size_t byte_size, size_t max_bytes) :
+        data(data), byte_size(byte_size),
+        max_chunks(max(max_bytes / CHUNK_SIZE, size_t(1))), last_chunk(-1),
+        hits(0), misses(0), spills(0), prefetches(0)
+{
+    size_t n_chunks = DIV_CEIL(byte_size, CHUNK_SIZE);
+    positions.resize(n_chunks);
+    resident.resize(n_chunks);
+    // the kernel should only read what is needed
+    madvise(data, byte_size, MADV_RANDOM);
+}
+
+void DiskCache::load(size_t chunk)
+{
+    ScopeLock _(lock);
+
+    if (chunk >= resident.size())
+        return;
+
+    if (resident[chunk])
+    {
+        hits++;
+        lru.splice(lru.begin(), lru, positions[chunk]);
+    }
+    else
+    {
+        misses++;
+        lru.push_front(chunk);
+        positions[chunk] = lru.begin();
+        resident[chunk] = true;
+
+        if (lru.size() > max_chunks)
+        {
+            size_t victim = lru.back();
+            lru.pop_back();
+            resident[victim] = false;
+            char* start = data + victim * CHUNK_SIZE;
+            size_t length = min(CHUNK_SIZE, byte_size - victim * CHUNK_SIZE);
+#ifdef MADV_PAGEOUT
+            // write back and reclaim
+            if (madvise(start, length, MADV_PAGEOUT))
+#endif
+            madvise(start, length, MADV_DONTNEED);
+            spills++;
+        }
+    }
+
+    // read ahead on sequential access
+    if (chunk == last_chunk + 1 and chunk + 1 < resident.size()
+            and not resident[chunk + 1])
+    {
+        char* start = data + (chunk + 1) * CHUNK_SIZE;
+        madvise(start, min(CHUNK_SIZE, byte_size - (chunk + 1) * CHUNK_SIZE),
+                MADV_WILLNEED);
+        prefetches++;
+    }
+
+    last_chunk = chunk;
+}
+
+void DiskCache::print_stats(const string& name)
+{
+    if (not OnlineOptions::singleton.verbose)
+        return;
+
+    size_t accesses = hits + misses;
+    cerr << name << " memory on disk: " << accesses << " accesses, "
+            << misses << " misses, " << spills << " spills, " << prefetches
+            << " prefetches";
+    if (accesses)
+        cerr << " (hit rate " << 100. * hits / accesses << "%)";
+    cerr << endl;
 }
@@ -9,15 +9,78 @@
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/filesystem.hpp>
 
+#include <list>
+#include <vector>
+#include <atomic>
+#include <string>
+
+#include "Tools/Lock.h"
+
+/**
+ * Keeps at most a given number of chunks of the file mapping in RAM.
+ * Least recently used chunks are written back and dropped, and
+ * sequential access triggers asynchronous read-ahead of the next chunk.
+ */
+class DiskCache
+{
+    static const size_t CHUNK_SIZE = 1 << 20;
+
+    char* data;
+    size_t byte_size;
+    size_t max_chunks;
+
+    Lock lock;
+    std::atomic<size_t> last_chunk;
+    std::list<size_t> lru;
+    std::vector<std::list<size_t>::iterator> positions;
+    std::vector<bool> resident;
+
+    std::atomic<size_t> hits;
+    size_t misses, spills, prefetches;
+
+    void load(size_t chunk);
+
+public:
+    DiskCache(char* data, size_t byte_size, size_t max_bytes);
+
+    void touch(size_t offset)
+    {
+        size_t chunk = offset / CHUNK_SIZE;
+        if (chunk == last_chunk.load(std::memory_order_relaxed))
+            hits.fetch_add(1, std::memory_order_relaxed);
+        else
+            load(chunk);
+    }
+
+    // every chunk overlapping [offset, offset + length)
+    void touch_range(size_t offset, size_t length)
+    {
+        if (length == 0)
+            return;
+        for (size_t chunk = offset / CHUNK_SIZE;
+                chunk <= (offset + length - 1) / CHUNK_SIZE; chunk++)
+            touch(chunk * CHUNK_SIZE);
+    }
+
+    void print_stats(const std::string& name);
+};
+
 class DiskVectorBase
 {
 protected:
     boost::iostreams::mapped_file file;
     boost::filesystem::path path;
+    DiskCache* cache;
 
 public:
+    DiskVectorBase() : cache(0)
+    {
+    }
+
     ~DiskVectorBase()
     {
+        if (cache)
+            delete cache;
         boost::filesystem::remove(path);
     }
 
@@ -35,6 +98,12 @@ public:
     {
     }
 
+    ~DiskVector()
+    {
+        if (cache)
+            cache->print_stats(T::type_string());
+    }
+
     size_t size() const
     {
         return size_;
@@ -48,6 +117,24 @@ public:
         data_ = (T*) file.data();
     }
 
+    bool tracks_access() const
+    {
+        return cache;
+    }
+
+    void touch(size_t index)
+    {
+        if (cache)
+            cache->touch(index * sizeof(T));
+    }
+
+    // call before accessing n elements via a pointer or data()
+    void touch_range(size_t start, size_t n) const
+    {
+        if (cache)
+            cache->touch_range(start * sizeof(T), n * sizeof(T));
+    }
+
     T* data()
     {
         return data_;
@@ -60,24 +147,27 @@ public:
 
     T& operator[](size_t index)
     {
+        touch(index);
         return data_[index];
     }
 
     const T& operator[](size_t index) const
     {
+        if (cache)
+            cache->touch(index * sizeof(T));
         return data_[index];
     }
 
     T& at(size_t index)
     {
         assert(index <= size_);
-        return data_[index];
+        return (*this)[index];
     }
 
     const T& at(size_t index) const
     {
         assert(index <= size_);
-        return data_[index];
+        return (*this)[index];
     }
 };
 
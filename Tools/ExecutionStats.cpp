@@ -10,6 +10,7 @@
 #include <iostream>
 #include <iomanip>
 #include <set>
+#include <algorithm>
 
 ExecutionStats& ExecutionStats::operator+=(const ExecutionStats& other)
 {
@@ -18,9 +19,9 @@ ExecutionStats& ExecutionStats::operator+=(const ExecutionStats& other)
     return *this;
 }
 
-void ExecutionStats::print()
+void ExecutionStats::print(const string& title)
 {
-    cerr << "Instruction statistics:" << endl;
+    cerr << title << ":" << endl;
     set<pair<size_t, int>> sorted_stats;
     for (auto& x : *this)
     {
@@ -46,7 +47,7 @@ void ExecutionStats::print()
             n_fill -= 5;
             cerr << setw(0);
         }
-        for (int i = 0; i < n_fill; i++)
+        for (int i = 0; i < max(n_fill, 1); i++)
             cerr << " ";
         cerr << dec << calls << endl;
         total += calls;
@@ -7,6 +7,7 @@
 #define TOOLS_EXECUTIONSTATS_H_
 
 #include <map>
+#include <string>
 using namespace std;
 
 class ExecutionStats : public map<int, size_t>
@@ -14,7 +15,7 @@ class ExecutionStats : public map<int, size_t>
 public:
     ExecutionStats& operator+=(const ExecutionStats& other);
 
-    void print();
+    void print(const string& title = "Instruction statistics");
 };
 
 #endif /* TOOLS_EXECUTIONSTATS_H_ */
@@ -0,0 +1,70 @@
+/*
+ * PagedVector.cpp
+ *
+ */
+
+#include "PagedVector.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <string.h>
+#include <new>
+#include <algorithm>
+using namespace std;
+
+size_t PagedVectorBase::page_size()
+{
+    static size_t res = sysconf(_SC_PAGESIZE);
+    return res;
+}
+
+void PagedVectorBase::resize_bytes(size_t new_size)
+{
+    size_t page = page_size();
+    size_t old_mapped = (byte_size + page - 1) / page * page;
+    size_t new_mapped = (new_size + page - 1) / page * page;
+
+    // the tail of the last page has to be zero when growing again
+    if (new_size < byte_size)
+        memset((char*) data_ + new_size, 0,
+                min(byte_size, new_mapped) - new_size);
+
+    if (new_mapped == old_mapped)
+    {
+        byte_size = new_size;
+        return;
+    }
+
+    void* res;
+    if (new_mapped == 0)
+    {
+        munmap(data_, old_mapped);
+        res = 0;
+    }
+    else if (old_mapped == 0)
+    {
+        res = mmap(0, new_mapped, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (res == MAP_FAILED)
+            throw std::bad_alloc();
+    }
+    else
+    {
+#ifdef __linux__
+        // keeps untouched pages uncommitted
+        res = mremap(data_, old_mapped, new_mapped, MREMAP_MAYMOVE);
+        if (res == MAP_FAILED)
+            throw std::bad_alloc();
+#else
+        res = mmap(0, new_mapped, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (res == MAP_FAILED)
+            throw std::bad_alloc();
+        memcpy(res, data_, min(old_mapped, new_mapped));
+        munmap(data_, old_mapped);
+#endif
+    }
+
+    data_ = res;
+    byte_size = new_size;
+}
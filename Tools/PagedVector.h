@@ -0,0 +1,95 @@
+/*
+ * PagedVector.h
+ *
+ */
+
+#ifndef TOOLS_PAGEDVECTOR_H_
+#define TOOLS_PAGEDVECTOR_H_
+
+#include <stddef.h>
+#include <assert.h>
+
+/**
+ * Memory that is only committed page by page when written to. Pages
+ * that are only read share the zero page. Like DiskVector, this
+ * requires that the all-zero byte pattern is a valid default value.
+ */
+class PagedVectorBase
+{
+    size_t byte_size;
+
+protected:
+    void* data_;
+
+    void resize_bytes(size_t new_size);
+
+public:
+    static size_t page_size();
+
+    PagedVectorBase() : byte_size(0), data_(0)
+    {
+    }
+
+    PagedVectorBase(const PagedVectorBase&) = delete;
+
+    ~PagedVectorBase()
+    {
+        resize_bytes(0);
+    }
+};
+
+template<class T>
+class PagedVector : PagedVectorBase
+{
+    size_t size_;
+
+public:
+    PagedVector() : size_(0)
+    {
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    void resize(size_t new_size)
+    {
+        resize_bytes(new_size * sizeof(T));
+        size_ = new_size;
+    }
+
+    T* data()
+    {
+        return (T*) data_;
+    }
+
+    const T* data() const
+    {
+        return (T*) data_;
+    }
+
+    T& operator[](size_t index)
+    {
+        return data()[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return data()[index];
+    }
+
+    T& at(size_t index)
+    {
+        assert(index < size_);
+        return data()[index];
+    }
+
+    const T& at(size_t index) const
+    {
+        assert(index < size_);
+        return data()[index];
+    }
+};
+
+#endif /* TOOLS_PAGEDVECTOR_H_ */
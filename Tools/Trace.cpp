@@ -0,0 +1,137 @@
+/*
+ * Trace.cpp
+ *
+ */
+
+#include "Trace.h"
+#include "Lock.h"
+#include "Exceptions.h"
+
+#include <time.h>
+#include <memory>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+bool Trace::active = false;
+long long Trace::origin = 0;
+
+namespace
+{
+Lock lock;
+// owned here so that events survive their thread
+vector<unique_ptr<Trace::Thread>> threads;
+thread_local Trace::Thread* my_thread = 0;
+
+void write_string(ostream& out, const string& str)
+{
+    out << '"';
+    for (char c : str)
+        if (c == '"' or c == '\\')
+            out << '\\' << c;
+        else if (c >= 0 and c < 0x20)
+            out << ' ';
+        else
+            out << c;
+    out << '"';
+}
+}
+
+void Trace::activate()
+{
+    origin = now();
+    active = true;
+}
+
+long long Trace::now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+Trace::Thread& Trace::thread()
+{
+    if (not my_thread)
+    {
+        ScopeLock _(lock);
+        threads.push_back(unique_ptr<Thread>(new Thread));
+        my_thread = threads.back().get();
+        my_thread->tid = threads.size();
+        my_thread->dropped = 0;
+    }
+    return *my_thread;
+}
+
+void Trace::name_thread(const string& name)
+{
+    if (active)
+        thread().name = name;
+}
+
+void Trace::add(const Event& event)
+{
+    auto& thread = Trace::thread();
+    if (thread.events.size() < MAX_EVENTS)
+        thread.events.push_back(event);
+    else
+        thread.dropped++;
+}
+
+void Trace::write(const string& filename)
+{
+    if (not active)
+        return;
+
+    ScopeLock _(lock);
+    ofstream out(filename);
+    if (out.fail())
+        throw file_error(filename);
+
+    out << fixed << setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << endl;
+    bool first = true;
+    auto separate = [&]() { out << (first ? "" : ",\n"); first = false; };
+    size_t dropped = 0;
+    for (auto& thread : threads)
+    {
+        if (not thread->name.empty())
+        {
+            separate();
+            out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":"
+                    << thread->tid << ",\"args\":{\"name\":";
+            write_string(out, thread->name);
+            out << "}}";
+        }
+
+        for (auto& event : thread->events)
+        {
+            separate();
+            out << "{\"ph\":\"X\",\"pid\":0,\"tid\":" << thread->tid
+                    << ",\"name\":";
+            write_string(out, event.name);
+            out << ",\"cat\":\"" << event.category << "\",\"ts\":"
+                    << (event.start - origin) * 1e-3 << ",\"dur\":"
+                    << event.duration * 1e-3;
+            if (event.peer >= 0 or event.bytes >= 0)
+            {
+                out << ",\"args\":{";
+                if (event.peer >= 0)
+                    out << "\"peer\":" << event.peer
+                            << (event.bytes >= 0 ? "," : "");
+                if (event.bytes >= 0)
+                    out << "\"bytes\":" << event.bytes;
+                out << "}";
+            }
+            out << "}";
+        }
+
+        dropped += thread->dropped;
+    }
+    out << "\n]}" << endl;
+
+    cerr << "Trace written to " << filename;
+    if (dropped)
+        cerr << " (" << dropped << " events dropped)";
+    cerr << endl;
+}
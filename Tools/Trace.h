@@ -0,0 +1,100 @@
+/*
+ * Trace.h
+ *
+ */
+
+#ifndef TOOLS_TRACE_H_
+#define TOOLS_TRACE_H_
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Timeline of spans per thread, written in the Chrome trace format
+ * (viewable with Perfetto or chrome://tracing)
+ */
+class Trace
+{
+public:
+    struct Event
+    {
+        string name;
+        const char* category;
+        long long start, duration;
+        int peer;
+        long long bytes;
+    };
+
+    struct Thread
+    {
+        int tid;
+        string name;
+        vector<Event> events;
+        size_t dropped;
+    };
+
+private:
+    static bool active;
+    static long long origin;
+
+    static Thread& thread();
+
+public:
+    // limit per thread to bound the memory usage
+    static const size_t MAX_EVENTS = 1 << 22;
+
+    static void activate();
+    static bool is_active() { return active; }
+
+    static long long now();
+
+    static void name_thread(const string& name);
+    static void add(const Event& event);
+
+    static void write(const string& filename);
+};
+
+/**
+ * Span from construction to destruction, recorded only if tracing is active
+ */
+class TraceScope
+{
+    const char* name;
+    string dynamic_name;
+    const char* category;
+    long long start;
+    int peer;
+    long long bytes;
+
+public:
+    TraceScope(const char* name, const char* category, int peer = -1,
+            long long bytes = -1) :
+            name(name), category(category), start(0), peer(peer),
+            bytes(bytes)
+    {
+        if (Trace::is_active())
+            start = Trace::now();
+    }
+
+    TraceScope(const string& name, const char* category) :
+            TraceScope((const char*) 0, category)
+    {
+        if (Trace::is_active())
+            dynamic_name = name;
+    }
+
+    ~TraceScope()
+    {
+        if (Trace::is_active() and start)
+            Trace::add({name ? name : dynamic_name, category, start,
+                    Trace::now() - start, peer, bytes});
+    }
+
+    void set_bytes(long long bytes)
+    {
+        this->bytes = bytes;
+    }
+};
+
+#endif /* TOOLS_TRACE_H_ */
@@ -48,6 +48,15 @@ inline bool cpu_has_avx2()
 #endif
 }
 
+inline bool cpu_has_avx512ifma()
+{
+#ifdef CHECK_AVX512IFMA
+    return check_cpu(7, false, 16) and check_cpu(7, false, 21);
+#else
+    return true;
+#endif
+}
+
 inline bool cpu_has_avx(bool force = false)
 {
     (void) force;
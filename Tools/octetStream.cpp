@@ -30,6 +30,15 @@ void octetStream::clear()
     reset();
 }
 
+void octetStream::swap(octetStream& os)
+{
+  std::swap(ptr, os.ptr);
+  std::swap(end, os.end);
+  std::swap(data, os.data);
+  std::swap(data_end, os.data_end);
+  std::swap(bits, os.bits);
+}
+
 void octetStream::assign(const octetStream& os)
 {
   auto read = os.get_ptr();
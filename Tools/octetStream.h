@@ -85,6 +85,8 @@ class octetStream
   void clear();
 
   void assign(const octetStream& os);
+  /// Exchange buffers without copying
+  void swap(octetStream& os);
 
   octetStream() : ptr(0), end(0), data(0), data_end(0) {}
   /// Initial buffer
@@ -266,6 +268,15 @@ class octetStream
   template<class T>
   void Receive(T socket_num);
 
+  /// Send several buffers on ``socket_num`` as one message without
+  /// concatenating them, to be received like a single buffer
+  template<class T>
+  static void Send(T socket_num, const vector<const octetStream*>& parts);
+  /// Receive message of known length on ``socket_num`` directly
+  /// to ``buffer`` without intermediate copy
+  template<class T>
+  static void Receive(T socket_num, octet* buffer, size_t length);
+
   /// Input from file, overwriting current content
   void input(const string& filename);
   /// Input from stream, overwriting current content
@@ -496,8 +507,37 @@ inline char octetStream::get_bits(int n_bits)
 template<class T>
 inline void octetStream::Send(T socket_num) const
 {
-  send(socket_num,get_length(),LENGTH_SIZE);
-  send(socket_num, get_data(), get_length());
+  // length and data in one go
+  octet blen[LENGTH_SIZE];
+  encode_length(blen, get_length(), LENGTH_SIZE);
+  iovec iov[] = {{blen, LENGTH_SIZE}, {get_data(), get_length()}};
+  send(socket_num, iov, 2);
+}
+
+template<class T>
+void octetStream::Send(T socket_num, const vector<const octetStream*>& parts)
+{
+  size_t length = 0;
+  for (auto part : parts)
+    length += part->get_length();
+
+  octet blen[LENGTH_SIZE];
+  encode_length(blen, length, LENGTH_SIZE);
+  vector<iovec> iov = {{blen, LENGTH_SIZE}};
+  for (auto part : parts)
+    iov.push_back({part->get_data(), part->get_length()});
+  send(socket_num, iov.data(), iov.size());
+}
+
+template<class T>
+void octetStream::Receive(T socket_num, octet* buffer, size_t length)
+{
+  size_t nlen = 0;
+  receive(socket_num, nlen, LENGTH_SIZE);
+  if (nlen != length)
+    throw runtime_error("unexpected message length: " + to_string(nlen)
+        + " instead of " + to_string(length));
+  receive(socket_num, buffer, length);
 }
 
 
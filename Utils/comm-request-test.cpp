@@ -0,0 +1,156 @@
+/*
+ * comm-request-test.cpp
+ *
+ * Runs three parties in threads to check Player::isend() and
+ * Player::irecv(): message order, recycling of send buffers, and
+ * waiting on completion, both directly and via the resharing in
+ * Replicated::start_exchange() and stop_exchange().
+ * Requires Scripts/setup-ssl.sh for the encrypted part.
+ */
+
+#include "Networking/CryptoPlayer.h"
+#include "Protocols/Rep3Share.h"
+#include "GC/SemiHonestRepPrep.h"
+#include "Protocols/Replicated.hpp"
+#include "Protocols/ReplicatedMC.hpp"
+#include "Protocols/MAC_Check_Base.hpp"
+#include "Math/Z2k.hpp"
+
+#include <thread>
+#include <atomic>
+
+atomic<int> failures;
+
+void check(bool ok, const string& what, const Player& P)
+{
+    if (not ok)
+    {
+        cerr << "P" << P.my_num() << ": " << what << " FAILED" << endl;
+        failures++;
+    }
+}
+
+// the same buffer comes back once the first request is done
+void test_reuse(const Player& P)
+{
+    int next = P.get_player(1), prev = P.get_player(-1);
+    octetStream os, received;
+    os.store(1);
+    auto data = os.get_data();
+    auto request = P.isend(next, os);
+    check(os.get_length() == 0 and os.get_data() != data, "swap", P);
+    request.wait();
+    check(not request.pending(), "not pending", P);
+    os.store(2);
+    request = P.isend(next, os);
+    check(os.get_data() == data, "buffer reuse", P);
+
+    for (int i = 1; i <= 2; i++)
+    {
+        P.irecv(prev, received).wait();
+        check(received.get_int(4) == size_t(i), "reuse content", P);
+    }
+}
+
+// requests are completed in order, also with large messages
+void test_order(const Player& P)
+{
+    int next = P.get_player(1), prev = P.get_player(-1);
+    const int n = 10;
+    vector<octetStream> received(n);
+    vector<CommRequest> sends, receives;
+    for (int i = 0; i < n; i++)
+        receives.push_back(P.irecv(prev, received[i]));
+    octetStream os;
+    vector<octet> padding(n * 100000);
+    for (int i = 0; i < n; i++)
+    {
+        os.store(i);
+        os.append(padding.data(), i * 100000);
+        sends.push_back(P.isend(next, os));
+    }
+    for (int i = 0; i < n; i++)
+    {
+        receives[i].wait();
+        check(received[i].get_int(4) == size_t(i)
+                and received[i].get_length() == 4 + i * 100000ul,
+                "order", P);
+    }
+}
+
+// destructors wait, after which direct communication is possible
+void test_wait(const Player& P)
+{
+    int next = P.get_player(1), prev = P.get_player(-1);
+    octetStream os, received;
+    {
+        os.store(3);
+        auto send = P.isend(next, os);
+        auto moved = std::move(send);
+        check(not send.pending() and moved.pending(), "move", P);
+        auto receive = P.irecv(prev, received);
+    }
+    check(received.get_int(4) == 3, "wait on destruction", P);
+    os.store(4);
+    P.pass_around(os, received, 1);
+    check(received.get_int(4) == 4, "direct after wait", P);
+}
+
+void test_replicated(Player& P)
+{
+    typedef Rep3Share<Z2<64>> T;
+    Replicated<T> protocol(P);
+    ReplicatedMC<T> MC;
+    int n = 1000;
+    for (int round = 0; round < 3; round++)
+    {
+        protocol.init_mul();
+        for (int i = 0; i < n; i++)
+            protocol.prepare_mul(T::constant(i, P.my_num()),
+                    T::constant(round + 1, P.my_num()));
+        protocol.start_exchange();
+        protocol.stop_exchange();
+        vector<T> products(n);
+        for (auto& x : products)
+            x = protocol.finalize_mul();
+        vector<T::open_type> opened;
+        MC.POpen(opened, products, P);
+        for (int i = 0; i < n; i++)
+            check(opened[i] == T::open_type(i * (round + 1)),
+                    "Rep3 multiplication", P);
+    }
+    MC.Check(P);
+}
+
+void run(int my_num)
+{
+    Names N(my_num, 14000, vector<string>(3, "localhost"));
+    PlainPlayer P(N, "plain");
+    test_reuse(P);
+    test_order(P);
+    test_wait(P);
+
+    // Rep3 refuses unencrypted communication
+    Names N2(my_num, 14010, vector<string>(3, "localhost"));
+    CryptoPlayer P2(N2, "encrypted");
+    test_reuse(P2);
+    test_order(P2);
+    test_wait(P2);
+    test_replicated(P2);
+}
+
+int main()
+{
+    vector<thread> threads;
+    for (int i = 0; i < 3; i++)
+        threads.push_back(thread(run, i));
+    for (auto& thread : threads)
+        thread.join();
+
+    if (failures)
+    {
+        cerr << failures << " failures" << endl;
+        return 1;
+    }
+    cout << "all ok" << endl;
+}
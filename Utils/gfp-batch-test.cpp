@@ -0,0 +1,79 @@
+/*
+ * gfp-batch-test.cpp
+ *
+ * Checks the batched Montgomery multiplication behind gfp_::mul_batch
+ * against elementwise multiplication for two-limb elements, with a
+ * modulus of one and of two limbs and various strides.
+ */
+
+#include "Math/gfp.hpp"
+#include "Math/modp.hpp"
+
+template<class T>
+bool test_strides(PRNG& G, int z_step, int x_step, int y_step)
+{
+    // not a multiple of the vector width
+    const int n = 37;
+    vector<T> x(n * x_step), y(n * y_step), z(n * z_step), w(n * z_step);
+    for (auto& a : x)
+        a.randomize(G);
+    for (auto& a : y)
+        a.randomize(G);
+    for (auto& a : z)
+        a.randomize(G);
+    w = z;
+
+    T::mul_batch(z.data(), x.data(), y.data(), n, z_step, x_step, y_step);
+
+    auto& ZpD = T::get_ZpD();
+    bool ok = true;
+    for (int i = 0; i < n; i++)
+    {
+        modp_<T::N_LIMBS> res;
+        Mul(res, x[i * x_step].get(), y[i * y_step].get(), ZpD);
+        w[i * z_step] = res;
+        if (ZpD.get_t() == T::N_LIMBS)
+            ok &= x[i * x_step] * y[i * y_step] == w[i * z_step];
+    }
+    // elements in between must stay untouched
+    return ok and z == w;
+}
+
+template<class T>
+int test(PRNG& G)
+{
+    int failures = 0;
+    for (int z_step = 1; z_step <= 3; z_step++)
+        for (int x_step = 1; x_step <= 3; x_step++)
+            for (int y_step = 1; y_step <= 3; y_step++)
+            {
+                bool ok = test_strides<T>(G, z_step, x_step, y_step);
+                cout << "L=" << T::N_LIMBS << " t=" << T::get_ZpD().get_t()
+                        << " steps " << z_step << "/" << x_step << "/"
+                        << y_step << ": " << (ok ? "ok" : "FAILED") << endl;
+                failures += not ok;
+            }
+    return failures;
+}
+
+int main()
+{
+    PRNG G;
+    G.ReSeed();
+
+    // gfp_::init_field() refuses a modulus shorter than L limbs,
+    // but the batched multiplication shouldn't depend on that
+    typedef gfp_<0, 2> T1;
+    typedef gfp_<1, 2> T2;
+    T1::get_ZpD().init(SPDZ_Data_Setup_Primes(64), true);
+    T2::init_field(SPDZ_Data_Setup_Primes(128));
+    assert(T1::get_ZpD().get_t() == 1);
+    assert(T2::get_ZpD().get_t() == 2);
+
+    int failures = test<T1>(G) + test<T2>(G);
+    if (failures)
+    {
+        cerr << failures << " failures" << endl;
+        return 1;
+    }
+}
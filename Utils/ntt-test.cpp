@@ -0,0 +1,164 @@
+/*
+ * ntt-test.cpp
+ *
+ * Checks the number-theoretic transform in FHE/NTT.h against the
+ * generic FFT routines for the ring dimensions and prime sizes
+ * where FFT_Data uses it.
+ */
+
+#include "FHE/FFT_Data.h"
+#include "FHE/FFT.h"
+#include "FHE/NTT.h"
+#include "FHE/Ring_Element.h"
+#include "FHE/Subroutines.h"
+#include "Math/modp.hpp"
+
+bigint find_prime(int bits, long mod)
+{
+    bigint p = (bigint(1) << (bits - 1)) / mod * mod + 1;
+    while (not probPrime(p))
+        p += mod;
+    return p;
+}
+
+// forward and inverse negacyclic transform against FFT_Iter2/FFT_Iter
+bool test_power_of_two(const FFT_Data& FFTD, const vector<modp>& a)
+{
+    auto& PrD = FFTD.get_prD();
+    int n = FFTD.phi_m();
+    vector<modp> b = a, c = a;
+    FFT_Iter2(b, n, FFTD.get_roots(), PrD);
+    FFTD.get_ntt(0).apply(c);
+    bool ok = b == c;
+
+    modp root2, w = FFTD.get_iphi();
+    Sqr(root2, FFTD.get_root(1), PrD);
+    FFT_Iter(b, n, root2, PrD);
+    for (int i = 0; i < n; i++)
+    {
+        Mul(b[i], b[i], w, PrD);
+        Mul(w, w, FFTD.get_root(1), PrD);
+    }
+    FFTD.get_ntt(1).apply(c);
+    return ok and b == c and b == a;
+}
+
+// cyclic transform used by Bluestein against FFT_Iter
+bool test_cyclic(int n, const Zp_Data& PrD, PRNG& G)
+{
+    modp root = Find_Primitive_Root_2power(n, PrD);
+    NTT ntt;
+    ntt.init(n, root, PrD);
+    vector<modp> a(n);
+    for (auto& x : a)
+        x.randomize(G, PrD);
+    vector<modp> b = a;
+    FFT_Iter(a, n, root, PrD);
+    ntt.apply(b);
+    return a == b;
+}
+
+// full evaluation for other cyclotomics against Horner's rule
+bool test_other(const FFT_Data& FFTD, const vector<modp>& a, PRNG& G)
+{
+    auto& PrD = FFTD.get_prD();
+    int n = FFTD.phi_m();
+    bool ok = test_cyclic(FFTD.get_twop(), PrD, G);
+
+    vector<modp> res(n);
+    FFT_non_power_of_two(res, a, FFTD);
+    for (int i = 0; i < n; i++)
+    {
+        modp r, acc;
+        Power(r, FFTD.get_root(0), FFTD.p(i), PrD);
+        assignZero(acc, PrD);
+        for (int j = n - 1; j >= 0; j--)
+        {
+            Mul(acc, acc, r, PrD);
+            Add(acc, acc, a[j], PrD);
+        }
+        ok &= acc == res[i];
+    }
+    return ok;
+}
+
+// round trip through Ring_Element
+bool test_ring_element(const FFT_Data& FFTD, const vector<modp>& a)
+{
+    Ring_Element e(FFTD, polynomial);
+    for (size_t i = 0; i < a.size(); i++)
+        e.set_element(i, a[i]);
+    e.change_rep(evaluation);
+    e.change_rep(polynomial);
+    bool ok = true;
+    for (size_t i = 0; i < a.size(); i++)
+        ok &= e.get_element(i) == a[i];
+    return ok;
+}
+
+int main()
+{
+    PRNG G;
+    G.ReSeed();
+    int failures = 0;
+
+    vector<int> ms = {4, 8, 16, 64, 1024, 4096, 8192, 32768, 65536, 131072};
+#ifdef USE_NTL
+    ms.insert(ms.end(), {35, 221, 1155});
+#else
+    cerr << "Skipping cyclotomics of other orders, which require NTL" << endl;
+#endif
+
+    for (int m : ms)
+        for (int bits : {20, 40, 58, 61, 62})
+        {
+            long twop = 1 << (numBits(m) + 1);
+            long mod = Hwt(m) == 1 ? 2 * m : twop * m / __gcd(twop, long(m));
+            if (bits < numBits(mod) + 2)
+                continue;
+            bigint p = find_prime(bits, mod);
+            if (numBits(p) != bits)
+                continue;
+
+            Ring R(m);
+            Zp_Data PrD(p);
+            FFT_Data FFTD(R, PrD);
+            vector<modp> a(FFTD.phi_m());
+            for (auto& x : a)
+                x.randomize(G, PrD);
+
+            bool ok = FFTD.get_ntt(0).active();
+            if (ok)
+            {
+                if (FFTD.get_twop() == 0)
+                    ok = test_power_of_two(FFTD, a);
+                else
+                    ok = test_other(FFTD, a, G);
+                ok &= test_ring_element(FFTD, a);
+            }
+
+            cout << "m=" << m << " " << bits << "-bit prime: "
+                    << (ok ? "ok" : "FAILED") << endl;
+            failures += not ok;
+        }
+
+    // the cyclic transform on its own doesn't need NTL
+    for (int n : {2, 64, 4096, 65536})
+        for (int bits : {20, 40, 58, 61, 62})
+        {
+            bigint p = find_prime(bits, n);
+            if (numBits(p) != bits)
+                continue;
+            Zp_Data PrD(p);
+            bool ok = test_cyclic(n, PrD, G);
+            cout << "cyclic n=" << n << " " << bits << "-bit prime: "
+                    << (ok ? "ok" : "FAILED") << endl;
+            failures += not ok;
+        }
+
+    if (failures)
+    {
+        cerr << failures << " failures" << endl;
+        return 1;
+    }
+}